@@ -0,0 +1,149 @@
+/*
+	Filename:   BIGALLOC.C
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+	
+	Allocation of the big tables (the window and the hash lists).
+	
+	On Linux a table of BIG_PAGE bytes or more is mapped with explicit
+	huge pages (MAP_HUGETLB) if the system has some reserved, or else
+	with transparent huge pages (madvise), so that a big window does
+	not thrash the TLB. Elsewhere it is just calloc().
+	
+	The memory comes zero-filled either way, and the pages are only
+	touched when they are first used.
+	
+	An arena: a program that knows the sizes of all its tables up front
+	takes them from one block, with arena_open(); big_alloc() then cuts
+	the tables from it, in order, each on an ARENA_ALIGN boundary (for
+	the SIMD loads), and big_free() of a table in it does nothing. A
+	table that does not fit is allocated on its own. The arena is of
+	one thread; a program with threads opens none. (10/19/2026)
+	
+	Hooks: the memory comes from the allocator of the program, if it sets
+	big_ALLOC and big_FREE (before it allocates anything); big_HUGE = 0
+	maps no huge pages. (10/19/2026)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "bigalloc.h"
+#if defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+/* the size of a mapping: a whole number of huge pages. */
+#define big_size(size) (((size)+BIG_PAGE-1) & ~(size_t) (BIG_PAGE-1))
+
+void *(*big_ALLOC)( void *opaque, size_t size ) = NULL;
+void (*big_FREE)( void *opaque, void *p, size_t size ) = NULL;
+void *big_OPAQUE = NULL;
+int big_HUGE = 1;
+
+/* the arena, and the bytes cut from it so far; arena_RAW is the
+	memory it is in, of arena_RAW_SIZE bytes. */
+static unsigned char *arena_BASE = NULL, *arena_RAW = NULL;
+static size_t arena_SIZE = 0, arena_USED = 0, arena_RAW_SIZE = 0;
+
+/* a mapping starts on a page; calloc() and the program's allocator
+	align less, so their arena has room to move its base up. */
+#if defined(__linux__)
+	#define big_mapped(size) (!big_ALLOC && (size) >= BIG_PAGE)
+#else
+	#define big_mapped(size) 0
+#endif
+
+static void *big_map( size_t size )
+{
+#if defined(__linux__)
+	void *p;
+	
+	if ( size >= BIG_PAGE ) {
+		#if defined(MAP_HUGETLB)
+		if ( big_HUGE ) {
+			p = mmap( NULL, big_size(size), PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+			if ( p != MAP_FAILED ) return p;
+		}
+		#endif
+		p = mmap( NULL, big_size(size), PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if ( p == MAP_FAILED ) return NULL;
+		#if defined(MADV_HUGEPAGE)
+		if ( big_HUGE ) madvise( p, big_size(size), MADV_HUGEPAGE );
+		#endif
+		return p;
+	}
+#endif
+	return calloc( size, 1 );
+}
+
+static void big_unmap( void *p, size_t size )
+{
+#if defined(__linux__)
+	if ( size >= BIG_PAGE ) {
+		munmap( p, big_size(size) );
+		return;
+	}
+#endif
+	free( p );
+}
+
+/* memory of the program's allocator, zero-filled; or of big_map(). */
+static void *big_get( size_t size )
+{
+	void *p;
+	
+	if ( !big_ALLOC ) return big_map( size );
+	if ( (p = big_ALLOC( big_OPAQUE, size ? size : 1 )) != NULL ) memset( p, 0, size );
+	return p;
+}
+
+static void big_put( void *p, size_t size )
+{
+	if ( big_FREE ) big_FREE( big_OPAQUE, p, size ? size : 1 );
+	else big_unmap( p, size );
+}
+
+void *big_alloc( size_t size )
+{
+	void *p;
+	
+	if ( arena_BASE && size > 0 && arena_SIZE-arena_USED >= arena_round(size) ) {
+		p = arena_BASE + arena_USED;
+		arena_USED += arena_round(size);
+		return p;
+	}
+	return big_get( size );
+}
+
+void big_free( void *p, size_t size )
+{
+	if ( !p ) return;
+	if ( arena_BASE && (unsigned char *) p >= arena_BASE
+		&& (unsigned char *) p < arena_BASE + arena_SIZE ) return;
+	big_put( p, size );
+}
+
+/* allocates an arena of size bytes (the sum of arena_round() of its
+	tables); returns 0 if there is not the memory. */
+int arena_open( size_t size )
+{
+	arena_close();
+	arena_RAW_SIZE = big_mapped(size) ? size : size + ARENA_ALIGN-1;
+	if ( (arena_RAW = (unsigned char *) big_get( arena_RAW_SIZE )) == NULL ) return 0;
+	arena_BASE = (unsigned char *) (((uintptr_t) arena_RAW + ARENA_ALIGN-1)
+		& ~(uintptr_t) (ARENA_ALIGN-1));
+	arena_SIZE = size;
+	arena_USED = 0;
+	return 1;
+}
+
+/* frees the arena, and all the tables in it. */
+void arena_close( void )
+{
+	if ( arena_RAW ) big_put( arena_RAW, arena_RAW_SIZE );
+	arena_BASE = arena_RAW = NULL;
+	arena_SIZE = arena_USED = arena_RAW_SIZE = 0;
+}
@@ -0,0 +1,30 @@
+/*
+	Filename:   BIGALLOC.H
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(BIGALLOC_H)
+	#define BIGALLOC_H
+
+#define BIG_PAGE  (2UL<<20)    /* a huge page, 2 MB. */
+
+/* the room of a table in an arena; the tables start on a cache line. */
+#define ARENA_ALIGN  64
+#define arena_round(size) (((size)+ARENA_ALIGN-1) & ~(size_t) (ARENA_ALIGN-1))
+
+/* the allocator of the program, if any; and huge pages, on by default. */
+extern void *(*big_ALLOC)( void *opaque, size_t size );
+extern void (*big_FREE)( void *opaque, void *p, size_t size );
+extern void *big_OPAQUE;
+extern int big_HUGE;
+
+/* ---- function prototypes. ---- */
+void *big_alloc( size_t size );
+void big_free( void *p, size_t size );
+int arena_open( size_t size );
+void arena_close( void );
+
+#endif
@@ -2,6 +2,13 @@
 	Filename:  GTBITIO3.C, Ver. 3, 8/22/2022, 6/27/2023
 	Author:    Gerald R. Tamayo
 	Written:   (2000/2003/2008/2022)
+
+	init_put_buffer() and init_get_buffer() keep the buffers of an earlier
+	call, for a program that codes many files; flush_put_buffer() clears
+	only the bytes it wrote. (10/19/2026)
+	
+	set_put_buffer() and set_get_buffer() hand in the buffers of the
+	program (say, from an arena), which are not freed here. (10/19/2026)
 */
 #include <stdio.h>
 #include <stdlib.h>
@@ -11,6 +18,7 @@
 
 FILE *gIN = NULL, *pOUT = NULL;
 unsigned int pBUFSIZE = 8192, gBUFSIZE = 8192;
+int pbuf_EXT = 0, gbuf_EXT = 0;   /* the buffers are of the program. */
 unsigned char *pbuf = NULL, *pbuf_start = NULL, p_cnt = 0;
 unsigned char *gbuf = NULL, *gbuf_start = NULL, *gbuf_end = NULL, g_cnt = 0;
 unsigned int bit_read = 0, nbits_read = 0;
@@ -22,8 +30,37 @@ void init_buffer_sizes( unsigned int size )
 	pBUFSIZE = gBUFSIZE = size;
 }
 
+/* the output buffer is buf, of size bytes, from now on. */
+void set_put_buffer( unsigned char *buf, unsigned int size )
+{
+	free_put_buffer();
+	pbuf = pbuf_start = buf;
+	pBUFSIZE = size;
+	pbuf_EXT = 1;
+	p_cnt = 0;
+	pbuf_count = 0;
+	memset( pbuf, 0, pBUFSIZE );
+}
+
+/* the input buffer is buf, of size bytes, from now on. */
+void set_get_buffer( unsigned char *buf, unsigned int size )
+{
+	free_get_buffer();
+	gbuf = gbuf_start = buf;
+	gBUFSIZE = size;
+	gbuf_EXT = 1;
+}
+
 void init_put_buffer( void )
 {
+	if ( pbuf_start ) {
+		memset( pbuf_start, 0, pbuf_count+1 );
+		pbuf = pbuf_start;
+		p_cnt = 0;
+		pbuf_count = 0;
+		nbytes_out = 0;
+		return;
+	}
 	p_cnt = 0;
 	pbuf = NULL;
 	pbuf_start = NULL;
@@ -50,14 +87,13 @@ void init_put_buffer( void )
 
 void init_get_buffer( void )
 {
-	gbuf = NULL;
-	gbuf_start = NULL;
+	gbuf = gbuf_start;
 	gbuf_end = NULL;
 	g_cnt = 0, nfread = 0;
 	nbytes_read = 0;
 	
 	/* Allocate MEMORY for BUFFERS. */
-	while ( 1 ) {
+	while ( !gbuf ) {
 		gbuf = (unsigned char *) malloc( sizeof(char) * gBUFSIZE );
 		if ( gbuf ) {
 			gbuf_start = gbuf;
@@ -78,22 +114,28 @@ void init_get_buffer( void )
 void free_put_buffer( void )
 {
 	pbuf = pbuf_start;
-	if ( pbuf ) free( pbuf );
+	if ( pbuf && !pbuf_EXT ) free( pbuf );
+	pbuf = pbuf_start = NULL;
+	pbuf_EXT = 0;
 }
 
 void free_get_buffer( void )
 {
 	gbuf = gbuf_start;
-	if ( gbuf ) free( gbuf );
+	if ( gbuf && !gbuf_EXT ) free( gbuf );
+	gbuf = gbuf_start = NULL;
+	gbuf_EXT = 0;
 }
 
 void flush_put_buffer( void )
 {
-	if ( pbuf_count || p_cnt ) {
-		fwrite( pbuf_start, pbuf_count+(p_cnt?1:0), 1, pOUT );
-		nbytes_out += (pbuf_count+(p_cnt?1:0));
+	unsigned int n = pbuf_count+(p_cnt?1:0);
+	
+	if ( n ) {
+		fwrite( pbuf_start, n, 1, pOUT );
+		nbytes_out += n;
 		pbuf = pbuf_start; pbuf_count = 0; p_cnt = 0;
-		memset( pbuf, 0, pBUFSIZE );
+		memset( pbuf, 0, n );
 	}
 }
 
@@ -172,6 +214,47 @@ static inline void pfputc( int c )
 	}
 }
 
+/* Gets n bytes from the input buffer; returns the number of bytes read.
+	Same as gfgetc(), call it only at a byte boundary. */
+static inline unsigned int gfread( unsigned char *p, unsigned int n )
+{
+	unsigned int k, total = 0;
+
+	while ( n && nfread ) {
+		k = (unsigned int) (gbuf_end - gbuf);
+		if ( k > n ) k = n;
+		memcpy( p, gbuf, k );
+		p += k, gbuf += k, total += k, n -= k;
+		if ( gbuf == gbuf_end ) {
+			nbytes_read += nfread;
+			gbuf = gbuf_start;
+			nfread = fread ( gbuf, 1, gBUFSIZE, gIN );
+			gbuf_end = (unsigned char *) (gbuf + nfread);
+		}
+	}
+	return total;
+}
+
+/* Puts n bytes into the output buffer. */
+static inline void pfwrite( const unsigned char *p, unsigned int n )
+{
+	unsigned int k;
+
+	while ( n ) {
+		k = pBUFSIZE - pbuf_count;
+		if ( k > n ) k = n;
+		memcpy( pbuf, p, k );
+		p += k, pbuf += k, n -= k;
+		if ( (pbuf_count += k) == pBUFSIZE ){
+			fwrite( pbuf_start, pBUFSIZE, 1, pOUT );
+			nbytes_out += pBUFSIZE;
+			pbuf_count = 0;
+			pbuf = pbuf_start;
+			memset( pbuf, 0, pBUFSIZE );
+		}
+	}
+}
+
 /* Multiple Bit Input/Output (2003/2004) */
 
 /* input more bits at a time; is faster. */
@@ -192,7 +275,7 @@ static inline unsigned int get_nbits( int size )
 		}
 		
 		if ( size ) do {
-			k |= ((*gbuf) << in_cnt);
+			k |= (unsigned int) *gbuf << in_cnt;
 			if ( size >= 8 ) { /* past one byte? */
 				size -= 8;
 				in_cnt += 8;
@@ -283,7 +366,7 @@ static inline int get_symbol( int size )
 			}
 		}
 		if ( size ) do {
-			k |= ((*gbuf) << in_cnt);
+			k |= (unsigned int) *gbuf << in_cnt;
 			if ( size >= 8 ) { /* past one byte? */
 				size -= 8;
 				in_cnt += 8;
@@ -66,6 +66,7 @@ number of bits.
 
 extern FILE *gIN, *pOUT;
 extern unsigned int pBUFSIZE, gBUFSIZE;
+extern int pbuf_EXT, gbuf_EXT;
 extern unsigned char *pbuf, *pbuf_start, p_cnt;
 extern unsigned char *gbuf, *gbuf_start, *gbuf_end, g_cnt;
 extern unsigned int bit_read, nbits_read;
@@ -74,6 +75,8 @@ extern int64_t nbytes_out, nbytes_read;
 
 void init_buffer_sizes( unsigned int size );
 void init_put_buffer( void );
+void set_put_buffer( unsigned char *buf, unsigned int size );
+void set_get_buffer( unsigned char *buf, unsigned int size );
 void init_get_buffer( void );
 void free_put_buffer( void );
 void free_get_buffer( void );
@@ -81,6 +84,8 @@ void flush_put_buffer( void );
 static inline int  get_bit( void );
 static inline int  gfgetc( void );
 static inline void pfputc( int c );
+static inline unsigned int gfread( unsigned char *p, unsigned int n );
+static inline void pfwrite( const unsigned char *p, unsigned int n );
 static inline unsigned int get_nbits( int size );
 static inline void put_nbits( unsigned int k, int size );
 static inline int get_symbol( int size );
@@ -0,0 +1,171 @@
+/*
+	Filename:  GTBITMEM.C, Ver. 1, 10/19/2026
+	Author:    Gerald R. Tamayo
+
+	Bit Input/Output on memory buffers, for the block-framed formats.
+	The reader keeps up to 64 bits in an accumulator and refills it
+	a whole word at a time, so get_nbits() rarely touches memory.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+#include "gtbitmem.h"
+
+#if defined(__GNUC__)
+	#define bm_ctz64(x) __builtin_ctzll(x)
+#else
+static inline int bm_ctz64( uint64_t x )
+{
+	int n = 0;
+
+	while ( !(x & 1) ) { x >>= 1; n++; }
+	return n;
+}
+#endif
+
+static inline void bm_init_put( bitmem_t *b, unsigned char *buf )
+{
+	b->bits = 0;
+	b->nbits = 0;
+	b->ptr = b->start = buf;
+	b->end = NULL;
+}
+
+static inline void bm_init_get( bitmem_t *b, unsigned char *buf, unsigned int size )
+{
+	b->bits = 0;
+	b->nbits = 0;
+	b->ptr = b->start = buf;
+	b->end = buf + size;
+}
+
+/* writes the last partial byte; returns the number of bytes written. */
+static inline unsigned int bm_flush( bitmem_t *b )
+{
+	if ( b->nbits > 0 ) {
+		*b->ptr++ = (unsigned char) b->bits;
+		b->bits = 0;
+		b->nbits = 0;
+	}
+	return (unsigned int) (b->ptr - b->start);
+}
+
+static inline void bm_put_nbits( bitmem_t *b, unsigned int k, int size )
+{
+	b->bits |= ((uint64_t) k & (((uint64_t) 1 << size)-1)) << b->nbits;
+	b->nbits += size;
+	while ( b->nbits >= 8 ) {
+		*b->ptr++ = (unsigned char) b->bits;
+		b->bits >>= 8;
+		b->nbits -= 8;
+	}
+}
+
+/* fill the accumulator; past the end of the buffer we read zeros. */
+static inline void bm_refill( bitmem_t *b )
+{
+	unsigned char *q = b->ptr;
+	int n;
+
+	if ( b->end - q >= 8 ) {
+		/* load 8 bytes; only the whole bytes that fit are consumed. */
+		b->bits |= ( (uint64_t) q[0] | ((uint64_t) q[1] << 8)
+			| ((uint64_t) q[2] << 16) | ((uint64_t) q[3] << 24)
+			| ((uint64_t) q[4] << 32) | ((uint64_t) q[5] << 40)
+			| ((uint64_t) q[6] << 48) | ((uint64_t) q[7] << 56) ) << b->nbits;
+		n = (63 - b->nbits) >> 3;
+		b->ptr += n;
+		b->nbits += n << 3;
+	}
+	else while ( b->nbits < 56 ) {
+		if ( b->ptr < b->end ) b->bits |= (uint64_t) (*b->ptr++) << b->nbits;
+		b->nbits += 8;
+	}
+}
+
+static inline unsigned int bm_get_nbits( bitmem_t *b, int size )
+{
+	unsigned int k;
+
+	if ( b->nbits < size ) bm_refill( b );
+	k = (unsigned int) (b->bits & (((uint64_t) 1 << size)-1));
+	b->bits >>= size;
+	b->nbits -= size;
+	return k;
+}
+
+static inline int bm_get_bit( bitmem_t *b )
+{
+	int bit;
+
+	if ( b->nbits == 0 ) bm_refill( b );
+	bit = (int) (b->bits & 1);
+	b->bits >>= 1;
+	b->nbits--;
+	return bit;
+}
+
+/* Golomb Codes; same bit layout as put_golomb() of ucodes3.c. */
+static inline void bm_put_golomb( bitmem_t *b, unsigned int n, int mfold )
+{
+	unsigned int i = n >> mfold;
+
+	while ( i >= 31 ) {
+		bm_put_nbits( b, 0x7fffffff, 31 );
+		i -= 31;
+	}
+	/* the unary ones and the terminating zero bit. */
+	bm_put_nbits( b, (1u<<i)-1, i+1 );
+	if ( mfold )
+		bm_put_nbits( b, n & ((1u<<mfold)-1), mfold );
+}
+
+/* the unary part is counted a whole accumulator at a time. */
+static inline unsigned int bm_get_golomb( bitmem_t *b, int mfold )
+{
+	unsigned int n = 0;
+	int z;
+	uint64_t t;
+
+	for ( ;; ) {
+		if ( b->nbits < 32 ) bm_refill( b );
+		t = ~b->bits & (((uint64_t) 1 << b->nbits)-1);
+		if ( t ) break;
+		n += b->nbits;
+		b->bits = 0;
+		b->nbits = 0;
+	}
+	z = bm_ctz64( t );
+	n += z;
+	b->bits >>= z+1;
+	b->nbits -= z+1;
+	n <<= mfold;
+	if ( mfold )
+		n += bm_get_nbits( b, mfold );
+
+	return n;
+}
+
+/* Variable-length codes; same bit layout as put_vlcode() of ucodes3.c. */
+static inline void bm_put_vlcode( bitmem_t *b, unsigned int n, int len )
+{
+	while ( n >= (1u<<len) ){
+		bm_put_nbits( b, 1, 1 );
+		n -= (1u<<len++);
+	}
+	bm_put_nbits( b, 0, 1 );
+	if ( len ) bm_put_nbits( b, n, len );
+}
+
+static inline unsigned int bm_get_vlcode( bitmem_t *b, int len )
+{
+	unsigned int n = 0;
+
+	while ( bm_get_bit( b ) ){
+		if ( len >= VLC_MAX_LEN ) return VLC_BAD;
+		n += (1u<<len++);
+	}
+	if ( len ) n += bm_get_nbits( b, len );
+	return n;
+}
@@ -0,0 +1,44 @@
+/* GTBITMEM.H, Ver. 1, 10/19/2026 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+
+#if !defined( GTBITMEM_H )
+	#define GTBITMEM_H
+
+/* Bit Input/Output on memory buffers.
+
+Unlike gtbitio3, the state of a bitstream is kept in a bitmem_t
+so that a coder can keep several independent bitstreams in flight.
+Bits are packed least-significant bit first, the same order as
+gtbitio3's put_nbits() and get_nbits().
+
+you can "get" and "put" at most 32 bits at a time.
+*/
+
+/* the longest variable-length code; a longer one is corrupt,
+	and bm_get_vlcode() returns VLC_BAD. */
+#define VLC_MAX_LEN  31
+#define VLC_BAD      0xffffffffu
+
+typedef struct {
+	uint64_t bits;          /* the bit accumulator. */
+	int nbits;              /* number of bits in the accumulator. */
+	unsigned char *ptr;     /* current byte. */
+	unsigned char *end;     /* end of input buffer. */
+	unsigned char *start;   /* start of buffer. */
+} bitmem_t;
+
+static inline void bm_init_put( bitmem_t *b, unsigned char *buf );
+static inline void bm_init_get( bitmem_t *b, unsigned char *buf, unsigned int size );
+static inline unsigned int bm_flush( bitmem_t *b );
+static inline void bm_put_nbits( bitmem_t *b, unsigned int k, int size );
+static inline unsigned int bm_get_nbits( bitmem_t *b, int size );
+static inline int bm_get_bit( bitmem_t *b );
+static inline void bm_put_golomb( bitmem_t *b, unsigned int n, int mfold );
+static inline unsigned int bm_get_golomb( bitmem_t *b, int mfold );
+static inline void bm_put_vlcode( bitmem_t *b, unsigned int n, int len );
+static inline unsigned int bm_get_vlcode( bitmem_t *b, int len );
+
+#endif
@@ -7,23 +7,41 @@
 	a hash table of "doubly-linked" lists.
 
     *hashp added to record hash of position (i) and faster delete_lznode() calls. (2/4/2023)
+    delete_lznode() ignores a position that was never inserted (h == LZ_NULL). (10/19/2026)
+    alloc_lzhash_lazy(): no table is initialized up front, see lz_head(). (10/19/2026)
+    alloc_lzhash_lazy(): the hash table (hsize) is sized apart from the lists (size). (10/19/2026)
+    alloc_lzhash_lazy(): the tables come from big_alloc() (huge pages). (10/19/2026)
+    The lists are instances of lzhash2t.c: of int, and of 16-bit nodes (the "16" names). (10/19/2026)
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "lzhash2.h"
+#include "bigalloc.h"
 
-/* stores the hashes of positions i */
-int *hashp = NULL;
+/* positions 0..lz_FILL-1 have a valid hashp[]. */
+int lz_FILL = 0;
+static int lz_SIZE = 0;
 
-/* this is the *hash table* of listheads. */
-int *lzhash = NULL;
+/* the hash table size, when the tables are from big_alloc(),
+	and the size of a node: the lists are of int or of 16-bit nodes. */
+static int lz_HSIZE = 0;
+static int lz_NODE = sizeof(int);
 
-/*
-	these arrays contain the "previous" and "next" pointers
-	of the virtual nodes.
-*/
-int *lzprev = NULL;
-int *lznext = NULL;
+/* the int lists: hashp, lzhash, lzprev, lznext, lz_head() ... */
+#define LZ_T       int
+#define LZ_NIL     LZ_NULL
+#define LZ_FN(f)   f
+#define LZ_SMALL   0
+#include "lzhash2t.c"
+
+/* the 16-bit lists, for windows and hash tables of 16 bits or less:
+	hashp16, lzhash16, lzprev16, lznext16, lz_head16() ... */
+#define LZ_T       uint16_t
+#define LZ_NIL     LZ_NULL16
+#define LZ_FN(f)   f##16
+#define LZ_SMALL   1
+#include "lzhash2t.c"
 
 /*
 	allocate memory to the hash table and linked-list tables.
@@ -59,44 +77,34 @@ int alloc_lzhash( int size )
 		lzprev[i] = LZ_NULL;
 		hashp[i] = LZ_NULL;
 	}
+	lz_SIZE = lz_FILL = size;
 	return 1;
 }
 
+/* ---- positions up to n-1 are now in use, but not in any list ---- */
+void fill_lznodes( int n )
+{
+	if ( n > lz_SIZE ) n = lz_SIZE;
+	if ( lz_NODE == sizeof(int) )
+		while ( lz_FILL < n ) hashp[lz_FILL++] = LZ_NULL;
+	else while ( lz_FILL < n ) hashp16[lz_FILL++] = LZ_NULL16;
+}
+
 void free_lzhash( void )
 {
+	if ( lz_HSIZE ) {
+		big_free( lzhash, sizeof(int) * lz_HSIZE );
+		big_free( lzprev, sizeof(int) * lz_SIZE );
+		big_free( lznext, sizeof(int) * lz_SIZE );
+		big_free( hashp, sizeof(int) * lz_SIZE );
+		big_free( lzhash16, sizeof(uint16_t) * lz_HSIZE );
+		big_free( lzprev16, sizeof(uint16_t) * lz_SIZE );
+		big_free( lznext16, sizeof(uint16_t) * lz_SIZE );
+		big_free( hashp16, sizeof(uint16_t) * lz_SIZE );
+		return;
+	}
 	if ( lzhash ) free( lzhash );
 	if ( lzprev ) free( lzprev );
 	if ( lznext ) free( lznext );
 	if ( hashp ) free( hashp );
 }
-
-/* ---- inserts a node (position i) into the hash list lzhash[h] ---- */
-void insert_lznode( int h, int i )
-{
-	int k = lzhash[h];
-	
-	hashp[i] = h;  /* record this hash for position i. */
-	
-	/* always insert at the beginning. */
-	lzhash[h] = i;
-	lzprev[i] = LZ_NULL;
-	lznext[i] = k;
-	if ( k != LZ_NULL ) lzprev[k] = i;
-	/* that's it! */
-}
-
-/* ---- deletes an LZ node (position i) ---- */
-void delete_lznode( int h, int i )
-{
-	if ( lzhash[h] == i ) { /* the head of the list? */
-		/* the next node becomes the head of the list */
-		lzhash[h] = lznext[i];
-		if ( lzhash[h] != LZ_NULL )  /* 4/25/2008 */
-			lzprev[ lzhash[h] ] = LZ_NULL;
-	}
-	else {
-		lznext[ lzprev[i] ] = lznext[i];
-		/* only if there is a node following node i, shall we assign to it. */
-		if ( lznext[i] != LZ_NULL ) lzprev[ lznext[i] ]= lzprev[i];
-	}
-}
@@ -5,21 +5,37 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #if !defined(LZHASH_H)
 	#define LZHASH_H
 
 #define LZ_NULL  -1
+#define LZ_NULL16  0xffff    /* the end of a 16-bit list. */
 
 extern int *hashp;
 extern int *lzhash;
 extern int *lzprev;
 extern int *lznext;
+extern int lz_FILL;
+
+/* the 16-bit lists (windows and hash tables of 16 bits or less). */
+extern uint16_t *hashp16;
+extern uint16_t *lzhash16;
+extern uint16_t *lzprev16;
+extern uint16_t *lznext16;
 
 /* ---- function prototypes. ---- */
 int alloc_lzhash( int size );
+int alloc_lzhash_lazy( int hsize, int size );
 void free_lzhash( void );
+void fill_lznodes( int n );
+int lz_head( int h );
 void insert_lznode( int h, int i );
 void delete_lznode( int h, int i );
+int alloc_lzhash_lazy16( int hsize, int size );
+int lz_head16( int h );
+void insert_lznode16( int h, int i );
+void delete_lznode16( int h, int i );
 
 #endif
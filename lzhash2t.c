@@ -0,0 +1,118 @@
+/*
+	Filename:   LZHASH2T.C
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+	
+	The hash lists of lzhash2.c, for one type of list node.
+	
+	This file is included by lzhash2.c once for each type, with:
+	
+	  LZ_T       the type of a position (and of a hash);
+	  LZ_NIL     the value of LZ_T that ends a list;
+	  LZ_FN(f)   the name of table or function f for this type;
+	  LZ_SMALL   1 if a position or a hash may equal LZ_NIL.
+	
+	The 16-bit lists cannot hold the position or the hash LZ_NIL (LZ_SMALL);
+	such a position is just not inserted. The tests compile away for int.
+*/
+
+/* stores the hashes of positions i */
+LZ_T *LZ_FN(hashp) = NULL;
+
+/* this is the *hash table* of listheads. */
+LZ_T *LZ_FN(lzhash) = NULL;
+
+/*
+	these arrays contain the "previous" and "next" pointers
+	of the virtual nodes.
+*/
+LZ_T *LZ_FN(lzprev) = NULL;
+LZ_T *LZ_FN(lznext) = NULL;
+
+/*
+	allocates a hash table of hsize listheads and the lists of size
+	positions, but leaves them uninitialized, so that the cost does
+	not depend on the sizes. The caller extends lz_FILL
+	with fill_lznodes() as positions are written, and list heads are
+	read with lz_head().
+*/
+int LZ_FN(alloc_lzhash_lazy)( int hsize, int size )
+{
+	LZ_FN(lzhash) = (LZ_T *) big_alloc( sizeof(LZ_T) * hsize );
+	LZ_FN(lzprev) = (LZ_T *) big_alloc( sizeof(LZ_T) * size );
+	LZ_FN(lznext) = (LZ_T *) big_alloc( sizeof(LZ_T) * size );
+	LZ_FN(hashp) = (LZ_T *) big_alloc( sizeof(LZ_T) * size );
+	lz_HSIZE = hsize;
+	lz_SIZE = size;
+	lz_NODE = sizeof(LZ_T);
+	if ( !LZ_FN(lzhash) || !LZ_FN(lzprev) || !LZ_FN(lznext) || !LZ_FN(hashp) ) {
+		fprintf(stderr, "\nError alloc: hash tables.");
+		return(0);
+	}
+	lz_FILL = 0;
+	return 1;
+}
+
+/*
+	---- the head of the list lzhash[h], or LZ_NULL ----
+	
+	a head that was never written may hold anything; it is valid
+	only if it names a filled position that was inserted in list h.
+*/
+int LZ_FN(lz_head)( int h )
+{
+	int i = LZ_FN(lzhash)[h];
+	
+	if ( !(LZ_SMALL && h == LZ_NIL) && (unsigned int) i < (unsigned int) lz_FILL
+		&& LZ_FN(hashp)[i] == h ) return i;
+	return LZ_NULL;
+}
+
+/* ---- the node after position i, or LZ_NULL ---- */
+static inline int LZ_FN(lz_next)( int i )
+{
+	int k = LZ_FN(lznext)[i];
+	
+	return k == LZ_NIL ? LZ_NULL : k;
+}
+
+/* ---- inserts a node (position i) into the hash list lzhash[h] ---- */
+void LZ_FN(insert_lznode)( int h, int i )
+{
+	int k = LZ_FN(lz_head)( h );
+	
+	if ( LZ_SMALL && (h == LZ_NIL || i == LZ_NIL) ) {
+		LZ_FN(hashp)[i] = LZ_NIL;  /* not in any list. */
+		return;
+	}
+	LZ_FN(hashp)[i] = h;  /* record this hash for position i. */
+	
+	/* always insert at the beginning. */
+	LZ_FN(lzhash)[h] = i;
+	LZ_FN(lzprev)[i] = LZ_NIL;
+	LZ_FN(lznext)[i] = k == LZ_NULL ? LZ_NIL : k;
+	if ( k != LZ_NULL ) LZ_FN(lzprev)[k] = i;
+	/* that's it! */
+}
+
+/* ---- deletes an LZ node (position i) ---- */
+void LZ_FN(delete_lznode)( int h, int i )
+{
+	if ( h == LZ_NIL ) return;  /* not in any list. */
+	if ( LZ_FN(lzhash)[h] == i ) { /* the head of the list? */
+		/* the next node becomes the head of the list */
+		LZ_FN(lzhash)[h] = LZ_FN(lznext)[i];
+		if ( LZ_FN(lzhash)[h] != LZ_NIL )  /* 4/25/2008 */
+			LZ_FN(lzprev)[ LZ_FN(lzhash)[h] ] = LZ_NIL;
+	}
+	else {
+		LZ_FN(lznext)[ LZ_FN(lzprev)[i] ] = LZ_FN(lznext)[i];
+		/* only if there is a node following node i, shall we assign to it. */
+		if ( LZ_FN(lznext)[i] != LZ_NIL ) LZ_FN(lzprev)[ LZ_FN(lznext)[i] ]= LZ_FN(lzprev)[i];
+	}
+}
+
+#undef LZ_T
+#undef LZ_NIL
+#undef LZ_FN
+#undef LZ_SMALL
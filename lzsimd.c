@@ -0,0 +1,201 @@
+/*
+	Filename:  LZSIMD.C, Ver. 1, 10/19/2026
+	Author:    Gerald R. Tamayo
+
+	The byte-compare kernels of the coder, in a scalar version and
+	in SSE2, AVX2 and AVX-512 versions that are compiled for their
+	instruction sets with target attributes, so that one binary
+	runs on any x86 host; simd_init() selects them at startup.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+#include "lzsimd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define SIMD_X86
+	#include <immintrin.h>
+#endif
+
+const char *simd_NAME[4] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+
+/* ---- scalar: 8 bytes at a time ---- */
+
+static unsigned int run_scan_scalar( const unsigned char *q, int c, unsigned int n )
+{
+	uint64_t v = 0x0101010101010101ULL * (unsigned char) c, x;
+	unsigned int i = 0;
+	
+	for ( ; i+8 <= n; i += 8 ) {
+		memcpy( &x, q+i, 8 );
+		if ( x != v ) break;
+	}
+	while ( i < n && q[i] == c ) i++;
+	return i;
+}
+
+static unsigned int match_len_scalar( const unsigned char *a, const unsigned char *b,
+	unsigned int n )
+{
+	uint64_t x, y;
+	unsigned int i = 0;
+	
+	for ( ; i+8 <= n; i += 8 ) {
+		memcpy( &x, a+i, 8 );
+		memcpy( &y, b+i, 8 );
+		if ( x != y ) break;
+	}
+	while ( i < n && a[i] == b[i] ) i++;
+	return i;
+}
+
+#if defined(SIMD_X86)
+
+/* ---- SSE2: 16 bytes at a time ---- */
+
+__attribute__((target("sse2")))
+static unsigned int run_scan_sse2( const unsigned char *q, int c, unsigned int n )
+{
+	__m128i v = _mm_set1_epi8( (char) c );
+	unsigned int i = 0, m;
+	
+	for ( ; i+16 <= n; i += 16 ) {
+		m = _mm_movemask_epi8( _mm_cmpeq_epi8(
+			_mm_loadu_si128( (const __m128i *) (q+i) ), v ) );
+		if ( m != 0xffff ) return i + __builtin_ctz( ~m );
+	}
+	while ( i < n && q[i] == c ) i++;
+	return i;
+}
+
+__attribute__((target("sse2")))
+static unsigned int match_len_sse2( const unsigned char *a, const unsigned char *b,
+	unsigned int n )
+{
+	unsigned int i = 0, m;
+	
+	for ( ; i+16 <= n; i += 16 ) {
+		m = _mm_movemask_epi8( _mm_cmpeq_epi8(
+			_mm_loadu_si128( (const __m128i *) (a+i) ),
+			_mm_loadu_si128( (const __m128i *) (b+i) ) ) );
+		if ( m != 0xffff ) return i + __builtin_ctz( ~m );
+	}
+	while ( i < n && a[i] == b[i] ) i++;
+	return i;
+}
+
+/* ---- AVX2: 32 bytes at a time ---- */
+
+__attribute__((target("avx2")))
+static unsigned int run_scan_avx2( const unsigned char *q, int c, unsigned int n )
+{
+	__m256i v = _mm256_set1_epi8( (char) c );
+	unsigned int i = 0, m;
+	
+	for ( ; i+32 <= n; i += 32 ) {
+		m = (unsigned int) _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+			_mm256_loadu_si256( (const __m256i *) (q+i) ), v ) );
+		if ( m != 0xffffffff ) return i + __builtin_ctz( ~m );
+	}
+	while ( i < n && q[i] == c ) i++;
+	return i;
+}
+
+__attribute__((target("avx2")))
+static unsigned int match_len_avx2( const unsigned char *a, const unsigned char *b,
+	unsigned int n )
+{
+	unsigned int i = 0, m;
+	
+	for ( ; i+32 <= n; i += 32 ) {
+		m = (unsigned int) _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+			_mm256_loadu_si256( (const __m256i *) (a+i) ),
+			_mm256_loadu_si256( (const __m256i *) (b+i) ) ) );
+		if ( m != 0xffffffff ) return i + __builtin_ctz( ~m );
+	}
+	while ( i < n && a[i] == b[i] ) i++;
+	return i;
+}
+
+/* ---- AVX-512: 64 bytes at a time, and a masked tail ---- */
+
+__attribute__((target("avx512f,avx512bw")))
+static unsigned int run_scan_avx512( const unsigned char *q, int c, unsigned int n )
+{
+	__m512i v = _mm512_set1_epi8( (char) c );
+	__mmask64 t;
+	uint64_t m;
+	unsigned int i = 0;
+	
+	for ( ; i < n; i += 64 ) {
+		t = n-i >= 64 ? ~(__mmask64) 0 : ((__mmask64) 1 << (n-i)) - 1;
+		m = _mm512_mask_cmpneq_epi8_mask( t, _mm512_maskz_loadu_epi8( t, q+i ), v );
+		if ( m ) return i + __builtin_ctzll( m );
+	}
+	return n;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static unsigned int match_len_avx512( const unsigned char *a, const unsigned char *b,
+	unsigned int n )
+{
+	__mmask64 t;
+	uint64_t m;
+	unsigned int i = 0;
+	
+	for ( ; i < n; i += 64 ) {
+		t = n-i >= 64 ? ~(__mmask64) 0 : ((__mmask64) 1 << (n-i)) - 1;
+		m = _mm512_mask_cmpneq_epi8_mask( t, _mm512_maskz_loadu_epi8( t, a+i ),
+			_mm512_maskz_loadu_epi8( t, b+i ) );
+		if ( m ) return i + __builtin_ctzll( m );
+	}
+	return n;
+}
+
+#endif
+
+unsigned int (*run_scan)( const unsigned char *q, int c, unsigned int n ) = run_scan_scalar;
+unsigned int (*match_len)( const unsigned char *a, const unsigned char *b,
+	unsigned int n ) = match_len_scalar;
+
+/* the best tier of the host. */
+int simd_detect( void )
+{
+#if defined(SIMD_X86)
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") )
+		return SIMD_AVX512;
+	if ( __builtin_cpu_supports("avx2") ) return SIMD_AVX2;
+	if ( __builtin_cpu_supports("sse2") ) return SIMD_SSE2;
+#endif
+	return SIMD_SCALAR;
+}
+
+/* selects the kernels of a tier (-1: the best), at most the host's; returns the tier. */
+int simd_init( int tier )
+{
+	int best = simd_detect();
+	
+	if ( tier < 0 || tier > best ) tier = best;
+	switch ( tier ) {
+#if defined(SIMD_X86)
+		case SIMD_AVX512:
+			run_scan = run_scan_avx512;
+			match_len = match_len_avx512;
+			break;
+		case SIMD_AVX2:
+			run_scan = run_scan_avx2;
+			match_len = match_len_avx2;
+			break;
+		case SIMD_SSE2:
+			run_scan = run_scan_sse2;
+			match_len = match_len_sse2;
+			break;
+#endif
+		default:
+			run_scan = run_scan_scalar;
+			match_len = match_len_scalar;
+	}
+	return tier;
+}
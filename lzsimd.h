@@ -0,0 +1,34 @@
+/* LZSIMD.H, Ver. 1, 10/19/2026 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+
+#if !defined( LZSIMD_H )
+	#define LZSIMD_H
+
+/* Byte-compare kernels, one for each SIMD tier.
+
+simd_init() picks the best tier of the host (cpuid), or a lower
+tier that is asked for, and points the kernels to it. The scalar
+kernels are always built; the SSE2, AVX2 and AVX-512 kernels only
+on x86 with GCC or Clang.
+*/
+#define SIMD_SCALAR   0
+#define SIMD_SSE2     1
+#define SIMD_AVX2     2
+#define SIMD_AVX512   3
+
+/* the length of the run of byte c at q[0..n-1]. */
+extern unsigned int (*run_scan)( const unsigned char *q, int c, unsigned int n );
+
+/* the length of the common prefix of a[0..n-1] and b[0..n-1]. */
+extern unsigned int (*match_len)( const unsigned char *a, const unsigned char *b,
+	unsigned int n );
+
+extern const char *simd_NAME[4];
+
+int simd_detect( void );
+int simd_init( int tier );
+
+#endif
@@ -0,0 +1,92 @@
+/*
+	Filename:   LZUF.H
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#if !defined(LZUF_H)
+	#define LZUF_H
+
+/* The library interface of lzuf624.c, which is compiled without its
+main() when LZUF_LIB is defined; the reader needs the threads library:
+
+	gcc -O2 -c -DLZUF_LIB lzuf624.c -pthread
+
+A reader reads the content of a seekable file (lzuf624 -x) at any
+offset, like pread(): the segment of content between two restart
+points is decoded when it is first read, and kept in a cache of at
+most cache_size bytes (LZUF_CACHE if 0), which drops the segments
+used least recently; it holds at least the segments being read. Any
+number of threads may read from the same reader.
+
+lzuf_open() returns NULL if the file is not a seekable LZUF file.
+lzuf_pread() returns the number of bytes read, which is less than
+len only at the end of the content, or -1 on a corrupt block (or a
+checksum mismatch, with -k).
+*/
+#define LZUF_CACHE  (64<<20)
+
+typedef struct lzuf_reader lzuf_reader;
+
+lzuf_reader *lzuf_open( const char *name, size_t cache_size );
+int64_t lzuf_pread( lzuf_reader *r, void *buf, size_t len, int64_t offset );
+int64_t lzuf_size( const lzuf_reader *r );
+void lzuf_close( lzuf_reader *r );
+
+/* A file of any of the LZUF coders, of either dialect (lzufmt.h)
+and any format, is decoded by lzuf_decompress_file(), like
+"lzuf624 -d in out"; a file written before the stamp had its
+dialect is of lzuf622 if mtf is 1, of lzuf624 if 0. It returns the
+content size, or -1 if a file cannot be opened, or the input is not
+an LZUF file or has a corrupt block. It uses the globals of the
+coder, so one thread at a time calls it.
+*/
+int64_t lzuf_decompress_file( const char *in, const char *out, int mtf );
+
+/* Small payloads (up to LZUF_SMALL_MAX bytes, say the values of a
+key-value store) are coded in memory, with a header of 2 to 4 bytes
+instead of a file stamp, and none of the buffers of the file coder.
+A context (about 192KB) holds the hash tables of the coder; it is
+made once and used for any number of payloads, by one thread at a
+time. The decoder needs no context.
+
+lzuf_compress_small() writes at most LZUF_SMALL_BOUND(n) bytes, and
+needs that room; it returns the size written, or -1 if the payload
+is too big or dst too small. lzuf_decompress_small() returns the
+raw size, or -1 if the payload is corrupt or does not fit in cap
+bytes; lzuf_small_size() gives the raw size from the header.
+*/
+#define LZUF_SMALL_MAX       65536
+#define LZUF_SMALL_BOUND(n)  ((n)+4)
+
+typedef struct lzuf_ctx lzuf_ctx;
+
+lzuf_ctx *lzuf_ctx_new( void );
+void lzuf_ctx_free( lzuf_ctx *c );
+int64_t lzuf_compress_small( lzuf_ctx *c, const void *src, size_t n, void *dst, size_t cap );
+int64_t lzuf_decompress_small( const void *src, size_t n, void *dst, size_t cap );
+int64_t lzuf_small_size( const void *src, size_t n );
+
+/* The memory of the readers and the contexts comes from the allocator
+of the program, say its own pools, if it sets one, before it opens a
+reader or makes a context (and it is the same until they are all
+freed). alloc() returns size bytes, aligned for any type, or NULL;
+free() gets the pointer and the size that alloc() gave. Without an
+allocator (alloc NULL, or lzuf_set_allocator( NULL )), the memory comes
+from malloc(), and a block of 2MB or more (a segment, say) is mapped
+with huge pages, unless huge_pages is 0. The memory of any allocator is
+zero-filled before it is used.
+*/
+typedef struct {
+	void *(*alloc)( void *opaque, size_t size );
+	void (*free)( void *opaque, void *p, size_t size );
+	void *opaque;             /* passed to alloc() and free(). */
+	int huge_pages;           /* with no alloc(), 1 for huge pages. */
+} lzuf_allocator;
+
+void lzuf_set_allocator( const lzuf_allocator *a );
+
+#endif
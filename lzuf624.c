@@ -11,6 +11,51 @@
 		(12/13/2023) Fast decode function.
 		(3/24/2024) Just a little faster coder function.
 		(11/09/2024) Changed hash bucket search list BITS default = 4.
+		(10/19/2026) Split-stream block format (-s): flags, lengths, positions and literals
+		             in separate streams per block, for a faster decoder.
+		(10/19/2026) Byte-aligned block format (-F): LZ4-style tokens, no bit-packing.
+		(10/19/2026) Literal-run coding (-r): one prefix and a run length per literal run.
+		(10/19/2026) Stored blocks for incompressible data in the block-framed formats.
+		(10/19/2026) Acceleration (-a): skip ahead when matches are not being found.
+		(10/19/2026) Sparse insertion (-i): rehash a sample of positions inside long matches.
+		(10/19/2026) Byte runs are coded as distance-1 matches in the block-framed formats;
+		             the zero-filled window is no longer inserted in the hash lists.
+		(10/19/2026) Constant-time startup: the window and the hash tables are not
+		             initialized up front.
+		(10/19/2026) Optional bitsize of the hash table (-h), BITS = 12..24, default = window
+		             bits; multiplicative hash of a 32-bit load.
+		(10/19/2026) An 8-byte hash table of the last position is probed before the list.
+		(10/19/2026) Repeat distances (-o): a match at one of the last 4 distances is coded
+		             in 3 bits instead of a position.
+		(10/19/2026) Literals are held back, and a match is extended backward over them.
+		(10/19/2026) Windows up to 26 bits (64MB); the big tables are allocated with
+		             huge pages where the system has them.
+		(10/19/2026) Long-distance matching (-l): repeats beyond the window, anywhere in
+		             the input, are coded as long-match blocks.
+		(10/19/2026) 16-bit hash lists for windows and hash tables of 16 bits or less.
+		(10/19/2026) The decoders are instantiated for each window size and literal
+		             coding, with the parameters as constants.
+		(10/19/2026) SIMD match extension and run scans, selected at startup (-t).
+		(10/19/2026) The file stamp records its version and dialect (lzufmt.h); the
+		             MTF-literal files of lzuf62..lzuf622 are decoded, and written (-m).
+		(10/19/2026) Frame version 2: a little-endian stamp with the content size
+		             up front, and optional block and content checksums (-k).
+		(10/19/2026) "-" is stdin or stdout; a stream of unknown size ends in-band,
+		             and the coder does not seek back.
+		(10/19/2026) Seekable frames (-x): restart points and a seek table, and a
+		             decoder of a range of the content (--range=start:len).
+		(10/19/2026) A reader of seekable files (lzuf.h), with a cache of decoded
+		             segments; built as a library with -DLZUF_LIB.
+		(10/19/2026) Small payloads in memory (lzuf.h), with a 2..4-byte header and
+		             a reusable context.
+		(10/19/2026) Batches (-b): the coder keeps its buffers and tables from one
+		             input to the next, and only resets them.
+		(10/19/2026) The buffers and tables of the coder, and of the decoder, are cut
+		             from one arena, sized up front; the library takes the allocator
+		             of the program (lzuf_set_allocator()).
+		(10/19/2026) One codec: lzuf62, lzuf621, lzuf622, lzufd62 and lzufd622 are
+		             built from this file (LZUF_ALIAS), as lzuf624 -m with their
+		             options; the library decodes a file of any of them.
 */
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,7 +66,14 @@
 #include "utypes.h"
 #include "gtbitio3.c"
 #include "ucodes3.c"
+#include "bigalloc.c"
 #include "lzhash2.c"
+#include "gtbitmem.c"
+#include "lzsimd.c"
+#include "mtf.c"
+#include "lzufmt.c"
+#include "xxh32.c"
+#include "lzuf.h"
 
 enum {
 	/* modes */
@@ -30,89 +82,399 @@ enum {
 };
 
 /* the decompressor's must also equal these values. */
-#define LTCB              17              /* 12..20 tested working */
+#define LTCB              17              /* 12..26 tested working */
 #ifdef LTCB 
     #define NUM_POS_BITS LTCB
 #else 
     #define NUM_POS_BITS  15
 #endif
+#define MAX_POS_BITS     26
+#define MAX_HASH_BITS    22    /* default hash table bits of the bigger windows. */
+
+/*
+	Memory used, for a window of W = 2^N bytes and a hash table of 2^H entries:
+	
+	  coder:    W (window) + W (pattern) + 12*W (hash lists) + 8*2^H (hash tables),
+	            plus ~2.5MB of block and i/o buffers; the lists take 6*W and the
+	            first hash table 2*2^H if N and H are both 16 or less;
+	  decoder:  2*W (-c), or 2*W + 64KB (-s, -F).
+	
+	With the default H = N (at most 22):
+	
+	  N = 17:   coder    2.75MB + 2.5MB,  decoder  256KB
+	  N = 20:   coder      22MB + 2.5MB,  decoder    2MB
+	  N = 22:   coder      88MB + 2.5MB,  decoder    8MB
+	  N = 24:   coder     256MB + 2.5MB,  decoder   32MB
+	  N = 26:   coder     928MB + 2.5MB,  decoder  128MB
+	
+	All of it is one arena (bigalloc.c), of coder_size() or decoder_size()
+	bytes; only the seek table (-x) grows apart from it.
+*/
 
 #define MIN_LEN           4               /* minimum string size >= 2 */
 #define MTF_SIZE        256
 #define FAR_LIST_BITS     4
 
 #define HASH_BYTES_N      4
+#define HASH8_BYTES_N     8
+#define LONG_MATCH       32    /* no list search after an 8-byte match this long. */
+#define SHORT_EXT        16    /* bytes compared one at a time before match_len(). */
+
+/* the format profiles and options (fstamp.format) are in lzufmt.h. */
+
+#define REP_N             4
+#define REP_BITS          2
+
+/* acceleration: after k misses in a row, the next (k*a_ACCEL) >> SKIP_TRIGGER
+   bytes are sent as literals with no search and no hashing. */
+#define SKIP_TRIGGER      6
+
+/* sparse insertion: inside a match longer than SPARSE_MIN, only the first
+   SPARSE_HEAD, the last SPARSE_TAIL and every i_STRIDE-th position are rehashed. */
+#define SPARSE_MIN       32
+#define SPARSE_HEAD       8
+#define SPARSE_TAIL      16
+
+/* byte runs: a run of RUN_MIN or more copies of the last byte is coded
+   as a distance-1 match, with no search; only its last RUN_TAIL
+   positions are rehashed, since all the others hash alike. */
+#define RUN_MIN          32
+#define RUN_TAIL          4
+
+#define LIT_RUN_BITS      0    /* vlcode length of literal run lengths. */
+#define LIT_RUN_MAX   65536    /* most held-back literals, FMT_STREAM. */
+
+/* block framing: see the frame in lzufmt.h. */
+#define BLOCK_BITS       16    /* block size, at most the window size. */
+
+/* seekable frames: a restart point every 2^SEEK_BITS bytes of content. */
+#define SEEK_BITS        20
+#define SEEK_MAX_BITS    30    /* the biggest segment a reader takes. */
+
+/* small payloads (lzuf.h): a hash table of about one entry per byte,
+   of 2^8..2^SMALL_HASH_BITS entries, and SMALL_DEPTH candidates searched
+   at a position; a payload of less than SMALL_MIN bytes is stored. */
+#define SMALL_HASH_BITS  14
+#define SMALL_DEPTH       8
+#define SMALL_MIN        16
 
-/* 4-byte hash */
-#define hash(buf,pos,mask1,mask2) \
-	(((buf[ (pos)&(mask1)]<<hash_SHIFT) \
-	^(buf[((pos)+1)&(mask1)]<<7) \
-	^(buf[((pos)+2)&(mask1)]<<4) \
-	^(buf[((pos)+3)&(mask1)]))&(mask2))
+/* long-distance matching: a gear hash of the last LDM_WIN bytes is sampled
+   at one position in 2^LDM_RATE, and kept in a table of 2^LDM_BITS entries. */
+#define LDM_WIN          64
+#define LDM_RATE          6
+#define LDM_BITS         20
+#define LDM_MIN_LEN     256    /* shorter repeats are left to search(). */
+#define LDM_MAX_LEN   (1<<30)
+#define LDM_CHUNK      4096    /* bytes compared at a time. */
+
+#if defined(_WIN32)
+	#include <io.h>
+	#include <fcntl.h>
+	#include <windows.h>
+	#define fseeko _fseeki64
+	#define ftello _ftelli64
+	#define set_binary(f) _setmode( _fileno(f), _O_BINARY )
+	#define rd_lock_t           CRITICAL_SECTION
+	#define rd_lock_init(m)     InitializeCriticalSection(m)
+	#define rd_lock(m)          EnterCriticalSection(m)
+	#define rd_unlock(m)        LeaveCriticalSection(m)
+	#define rd_lock_free(m)     DeleteCriticalSection(m)
+	#define rd_once_t           INIT_ONCE
+	#define RD_ONCE_INIT        INIT_ONCE_STATIC_INIT
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <errno.h>
+	#include <pthread.h>
+	#define set_binary(f)
+	#define rd_lock_t           pthread_mutex_t
+	#define rd_lock_init(m)     pthread_mutex_init( m, NULL )
+	#define rd_lock(m)          pthread_mutex_lock(m)
+	#define rd_unlock(m)        pthread_mutex_unlock(m)
+	#define rd_lock_free(m)     pthread_mutex_destroy(m)
+	#define rd_once_t           pthread_once_t
+	#define RD_ONCE_INIT        PTHREAD_ONCE_INIT
+#endif
+
+/* a block is stored without a search when its order-2 (collision)
+   entropy is above ~7.9 bits per byte: sum(c*c)*239 < n*n. */
+#define STORE_ENTROPY   239
+#define STORE_PROBES      4    /* and search() finds nothing at 4 points */
+#define STORE_STRIDE      8    /* of 8 positions; every 8th stored position is hashed. */
+
+/* 4-byte and 8-byte hashes: multiplicative hashes of a 32-bit and a
+   64-bit load. The first HASH8_BYTES_N-1 bytes of the window and of the
+   pattern buffer are mirrored past their ends, so a load never wraps around. */
+#define HASH_MUL  2654435761u
+#define HASH8_MUL 0x9E3779B97F4A7C15ull
+#define hash(buf,pos) ((load32((buf)+(pos)) * HASH_MUL) >> hash_SHIFT)
+#define hash8(buf,pos) ((unsigned int) ((load64((buf)+(pos)) * HASH8_MUL) >> (hash_SHIFT+32)))
+#define mirror(buf,size) memcpy( (buf)+(size), (buf), HASH8_BYTES_N-1 )
+
+/* a decoder kernel is inlined into each of its instances, and an instance
+   has all its calls inlined (see DECODERS). */
+#if defined(__GNUC__)
+	#define KERNEL static inline __attribute__((always_inline))
+	#define INSTANCE static __attribute__((flatten))
+#else
+	#define KERNEL static inline
+	#define INSTANCE static
+#endif
+
+static inline uint32_t load32( const unsigned char *b )
+{
+	uint32_t x;
 	
-typedef struct {
-	char algorithm[8];
-	int64_t file_size;
-	int num_pos_bits;
-} file_stamp;
+	memcpy( &x, b, 4 );
+	return x;
+}
 
+static inline uint64_t load64( const unsigned char *b )
+{
+	uint64_t x;
+	
+	memcpy( &x, b, 8 );
+	return x;
+}
+	
 typedef struct {
 	unsigned int pos, len;
 } dpos_t;
 
+/* a position of the input and the gear hash of the LDM_WIN bytes ending there. */
+typedef struct {
+	int64_t pos;
+	uint64_t hash;
+} ldm_t;
+
+/* a block is parsed into sequences: a run of literals followed by a match. */
+typedef struct {
+	unsigned int lit, len, dist;
+} seq_t;
+
 unsigned int num_POS_BITS = NUM_POS_BITS; /* default */
 unsigned int win_BUFSIZE  = 1<<NUM_POS_BITS;
 unsigned int win_MASK;
+unsigned int hash_BITS = 0;        /* default, the window bits (at most MAX_HASH_BITS). */
 unsigned int hash_SHIFT;
 unsigned int pat_BUFSIZE;   /* must be a power of 2. */
 unsigned int pat_MASK;
 int far_LIST_BITS = FAR_LIST_BITS;  /* default */
 int far_LIST = 1<<FAR_LIST_BITS;
+unsigned int a_ACCEL = 0;           /* default, no acceleration. */
+int i_STRIDE = 1;                   /* default, rehash every position. */
+int simd_TIER = -1;                 /* default, the best of the host. */
 
 dpos_t dpos;
-unsigned char *win_buf;     /* the "sliding" window buffer. Max = 20 bits or 1MB */
+unsigned char *win_buf;     /* the "sliding" window buffer. Max = 26 bits or 64MB */
 unsigned char *pattern;
 int win_cnt = 0, pat_cnt = 0, buf_cnt = 0;  /* some counters. */
 int len_CODE = 0;     /* the transmitted length code. */
 file_stamp fstamp;
+int fmt_PROF = FMT_STREAM;        /* fstamp.format & FMT_MASK */
+int lit_RUNS = 0;                 /* fstamp.format & FMT_LITRUNS */
+int rep_MODE = 0;                 /* fstamp.format & FMT_REPS */
+int mtf_MODE = 0;                 /* the dialect is LZUF_MTF. */
+int sum_MODE = 0;                 /* fstamp.format & FMT_CHECKSUM */
+xxh32_t blk_SUM, frame_SUM;       /* the checksums of the block and the content. */
+int eos_MODE = 0;                 /* fstamp.format & FMT_EOS */
+
+/* seekable frames; the coder keeps the restart points for the seek
+   table, and a range is read with a reader (lzuf.h). */
+int seek_MODE = 0;                /* fstamp.format & FMT_SEEK */
+int seek_BITS = SEEK_BITS;
+int64_t *seek_TAB = NULL;         /* content and frame offsets, in pairs. */
+unsigned int seek_N = 0, seek_MAX = 0;
+int rng_MODE = 0;                 /* --range */
+int64_t rng_START = 0, rng_END = INT64_MAX;
+unsigned int rep_DIST[REP_N];     /* the last distances, most recent first. */
+unsigned int lit_cnt = 0;         /* held-back literals, FMT_STREAM. */
+
+/* block-framed formats. */
+int blk_MODE = 0;                 /* matches are coded as distances. */
+int blk_left = INT_MAX;           /* bytes left in the current block. */
+unsigned int blk_SIZE;
+unsigned int hist_CNT = 0;        /* bytes of real history behind win_cnt. */
+seq_t *seq_buf;
+unsigned char *lit_buf, *blk_buf, *bm_buf[3];
+
+/* the last position of each 8-byte hash; not initialized, so a
+   position is used only if it is below lz_FILL. The bits above
+   MAX_POS_BITS are the generation of the entry (lz8_GEN), which is
+   that of the input being coded; there are LZ8_GEN_MAX of them. */
+int *lzhash8 = NULL;
+unsigned int lz8_GEN = 1;
+#define LZ8_GEN_MAX      31
+
+/* batches: the infile is a list of input files, one per line, and the
+   outfile the suffix of their output names. */
+int batch_MODE = 0;
+unsigned int batch_N = 0, batch_FAIL = 0;
+int coder_USED = 0;               /* the buffers hold an earlier input. */
+
+/* the hash lists are of 16-bit nodes (lzhash16, ...). */
+int lz_NARROW = 0;
+
+/* long-distance matching; the coder reads the input file again
+   to compare far bytes, and the decoder reads its output file. */
+int ldm_MODE = 0;                 /* fstamp.format & FMT_LONG */
+FILE *ldm_FILE = NULL;
+ldm_t *ldm_TABLE = NULL;
+uint64_t ldm_GEAR[256];
+uint64_t ldm_HASH = 0;
+int64_t in_POS = 0;               /* input offset of pat_cnt. */
+int64_t ldm_NEXT = 0;             /* the next input byte to hash. */
+int64_t ldm_FED = 0;              /* bytes hashed since the last reset. */
+int64_t ldm_BASE = 0;             /* the bytes of earlier inputs (-b); the
+                                     table has their offsets, plus ldm_BASE. */
+int64_t ldm_AT, ldm_DIST;         /* the long match found; */
+unsigned int ldm_LEN = 0;         /* 0 if none. */
+unsigned char *ldm_buf[2];
 
 void copyright( void );
 void alloc_buffers( void );
+size_t coder_size( void );
+size_t decoder_size( void );
+int init_decoder( void );
+int decode_file( const char *name );
 void compress( unsigned char *w, unsigned char *p );
+static inline void put_literals( void );
+static inline void skip_literals( unsigned char *w, unsigned char *p, unsigned int n );
 void decompress( unsigned char *w, unsigned char *p );
+void alloc_blocks( void );
+void free_blocks( void );
+void compress_blocks( unsigned char *w, unsigned char *p );
+int decompress_blocks( void );
 static inline void search( unsigned char *w, unsigned char *p );
-static inline void put_codes( unsigned char *w, unsigned char *p );
+static inline void put_codes( unsigned char *w, unsigned char *p, unsigned int back );
+static inline unsigned int extend_back( unsigned char *w, unsigned int n, unsigned int d,
+	unsigned int len );
+static inline void init_reps( unsigned int *r );
+static inline int update_reps( unsigned int *r, unsigned int d );
+KERNEL unsigned int get_pos( const int wb, const int reps );
+static inline void rehash( unsigned char *w, int k );
+static inline void rehash8( unsigned char *w, int k, int n, int stride );
+static inline void slide( unsigned char *w, unsigned char *p );
+static inline void slide_raw( unsigned char *w, unsigned char *p, int n, int stride );
+static inline void slide_run( unsigned char *w, unsigned char *p, int n );
+static inline unsigned int run_length( unsigned char *w, unsigned char *p );
+void ldm_init( void );
+static inline void ldm_scan( unsigned char *p, unsigned int n );
+static inline void put_long( unsigned char *w, unsigned char *p );
+void put_seek_table( void );
+void read_range( const char *name );
+int init_coder( void );
+void reset_coder( void );
+int compress_input( const char *name );
+void compress_batch( const char *suffix );
+
+#if !defined(LZUF_LIB)
+/*
+The older programs are built from this file, with LZUF_ALIAS set to
+one of these (lzuf62.c and the others): each is lzuf624 -m, with the
+options it had; the decoders also take the files of lzuf624.
+*/
+#define ALIAS_LZUF62     1
+#define ALIAS_LZUF621    2
+#define ALIAS_LZUF622    3
+#define ALIAS_LZUFD62    4
+#define ALIAS_LZUFD622   5
+
+#if defined(LZUF_ALIAS)
+static const char *alias_USAGE[] = { NULL,
+	"lzuf62 [-N] infile outfile",
+	"lzuf621 [-cN] [-fM] infile outfile (M default=9)",
+	"lzuf622 [-c[N]] [-fM] [-d] infile outfile",
+	"lzufd62 infile outfile",
+	"lzufd622 infile outfile"
+};
+#endif
 
 void usage( void )
 {
+#if defined(LZUF_ALIAS)
+	fprintf(stderr, "\n Usage: %s\n\n (lzuf624 -m; the options of lzuf624 below are taken too.)\n",
+		alias_USAGE[ LZUF_ALIAS ] );
+#endif
 	fprintf(stderr, "\n Lzuf624 compressor v2.5.0\n");
-	fprintf(stderr, "\n Usage: lzuf624 [-c[N]] [-fM] [-d] infile outfile\n\n where c = encoding/compression.");
-	fprintf(stderr, "\n       N = nbits size (N = 12..20) of window buffer, default=17;");
-	fprintf(stderr, "\n       M = bitsize of hash bucket search list (M = 1..12) default=4.");
-	fprintf(stderr, "\n       d = decoding.");
+	fprintf(stderr, "\n Usage: lzuf624 [-c[N]] [-fM] [-hH] [-aA] [-iI] [-s|-F] [-r] [-o] [-l] [-k] [-x[X]] [-m] [-tT]\n        [-b] [-d [--range=S:L]] infile outfile\n\n where c = encoding/compression.");
+	fprintf(stderr, "\n       infile or outfile \"-\" is stdin or stdout.");
+	fprintf(stderr, "\n       N = nbits size (N = 12..26) of window buffer, default=17;");
+	fprintf(stderr, "\n       M = bitsize of hash bucket search list (M = 1..12) default=4;");
+	fprintf(stderr, "\n       H = bitsize of hash table (H = 12..24), default=N (at most 22);");
+	fprintf(stderr, "\n       A = acceleration (A = 1..64), faster on data with few matches;");
+	fprintf(stderr, "\n       I = insert every I-th position inside long matches (I = 1..256).");
+	fprintf(stderr, "\n       s = split-stream block format (faster decoding).");
+	fprintf(stderr, "\n       F = byte-aligned block format (fastest decoding).");
+	fprintf(stderr, "\n       r = code literal runs (not with -F).");
+	fprintf(stderr, "\n       o = code repeat distances (not with -F).");
+	fprintf(stderr, "\n       l = long-distance matching, beyond the window (with -s or -F).");
+	fprintf(stderr, "\n       k = block and content checksums (with -s or -F).");
+	fprintf(stderr, "\n       x = seekable, a restart point every 2^X bytes (X = 16..30), default=20");
+	fprintf(stderr, "\n           (with -s or -F, not with -l).");
+	fprintf(stderr, "\n       b = batch: infile lists the files to code, one per line, and each");
+	fprintf(stderr, "\n           is written to its name + outfile (say, \".lzu\").");
+	fprintf(stderr, "\n       m = MTF-coded literals, the files of lzuf622 (not with -s, -F, -r,");
+	fprintf(stderr, "\n           -o or -l); with -d, an older file with no dialect is of lzuf622.");
+	fprintf(stderr, "\n       T = SIMD tier (T = 0 scalar, 1 SSE2, 2 AVX2, 3 AVX-512), default=best;");
+	fprintf(stderr, "\n       d = decoding;");
+	fprintf(stderr, "\n       S:L = decode only the L bytes from offset S (with -s or -F).");
 	copyright();
 	exit (0);
 }
 
+#if defined(LZUF_ALIAS)
+/* the arguments of lzuf624 for those of the older program. */
+char **alias_args( int *argc, char *argv[] )
+{
+	static char *a[20], c[16];
+	int i, n = 0;
+	
+	if ( *argc < 3 || *argc > 16 ) usage();
+	a[n++] = argv[0];
+	a[n++] = "-m";
+	if ( LZUF_ALIAS == ALIAS_LZUFD62 || LZUF_ALIAS == ALIAS_LZUFD622 ) a[n++] = "-d";
+	if ( LZUF_ALIAS == ALIAS_LZUF621 ) {
+		far_LIST_BITS = 9;
+		far_LIST = 1<<far_LIST_BITS;
+	}
+	for ( i = 1; i < *argc; i++ ) {
+		/* the window of lzuf62 is -N. */
+		if ( LZUF_ALIAS == ALIAS_LZUF62 && argv[i][0] == '-' && isdigit( (unsigned char) argv[i][1] )
+			&& strlen( argv[i] ) < sizeof(c)-1 ) {
+			sprintf( c, "-c%s", &argv[i][1] );
+			a[n++] = c;
+		}
+		else a[n++] = argv[i];
+	}
+	*argc = n;
+	return a;
+}
+#endif
+
 int main( int argc, char *argv[] )
 {
 	float ratio = 0.0;
-	int i, mode = -1, in_argn = 0, out_argn = 0, fcount = 0, n;
+	int mode = -1, in_argn = 0, out_argn = 0, fcount = 0, n;
 	
 	clock_t start_time = clock();
 	
+#if defined(LZUF_ALIAS)
+	argv = alias_args( &argc, argv );
+#endif
 	/* command-line handler */
-	if ( argc < 3 || argc > 5 ) usage();
+	if ( argc < 3 || argc > 18 ) usage();
 	else if ( argc == 3 ) mode = COMPRESS;
 	n = 1;
 	while ( n < argc ){
-		if ( argv[n][0] == '-' ){
-			switch( tolower(argv[n][1]) ){
+		if ( argv[n][0] == '-' && argv[n][1] != 0 ){
+			/* -F and -f are different options. */
+			switch( argv[n][1] == 'F' ? 'F' : tolower(argv[n][1]) ){
 				case 'c':
 					if ( argv[n][2] != 0 ){
 						num_POS_BITS = atoi(&argv[n][2]);
 						if ( num_POS_BITS < 12 ) usage();
-						else if ( num_POS_BITS > 20 ) usage();
+						else if ( num_POS_BITS > MAX_POS_BITS ) usage();
 					}
 					if ( mode == DECOMPRESS ) usage();
 					else mode = COMPRESS;
@@ -125,6 +487,83 @@ int main( int argc, char *argv[] )
 					if ( mode == DECOMPRESS ) usage();
 					else mode = COMPRESS;
 					break;
+				case 's':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					fmt_PROF = FMT_SPLIT;
+					mode = COMPRESS;
+					break;
+				case 'F':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					fmt_PROF = FMT_BYTE;
+					mode = COMPRESS;
+					break;
+				case 'h':
+					hash_BITS = atoi(&argv[n][2]);
+					if ( hash_BITS < 12 || hash_BITS > 24 ) usage();
+					if ( mode == DECOMPRESS ) usage();
+					else mode = COMPRESS;
+					break;
+				case 'a':
+					a_ACCEL = atoi(&argv[n][2]);
+					if ( a_ACCEL == 0 || a_ACCEL > 64 ) usage();
+					if ( mode == DECOMPRESS ) usage();
+					else mode = COMPRESS;
+					break;
+				case 'i':
+					i_STRIDE = atoi(&argv[n][2]);
+					if ( i_STRIDE < 1 || i_STRIDE > 256 ) usage();
+					if ( mode == DECOMPRESS ) usage();
+					else mode = COMPRESS;
+					break;
+				case 'r':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					lit_RUNS = 1;
+					mode = COMPRESS;
+					break;
+				case 'o':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					rep_MODE = 1;
+					mode = COMPRESS;
+					break;
+				case 'l':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					ldm_MODE = 1;
+					mode = COMPRESS;
+					break;
+				case 'k':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					sum_MODE = 1;
+					mode = COMPRESS;
+					break;
+				case 'b':
+					if ( argv[n][2] != 0 || mode == DECOMPRESS ) usage();
+					batch_MODE = 1;
+					mode = COMPRESS;
+					break;
+				case 'x':
+					if ( argv[n][2] != 0 ) seek_BITS = atoi(&argv[n][2]);
+					if ( seek_BITS < 16 || seek_BITS > SEEK_MAX_BITS || mode == DECOMPRESS ) usage();
+					seek_MODE = 1;
+					mode = COMPRESS;
+					break;
+				case '-':
+					if ( strncmp( argv[n], "--range=", 8 ) != 0 || mode == COMPRESS ) usage();
+					if ( sscanf( &argv[n][8], "%lld:%lld", (long long *) &rng_START,
+						(long long *) &rng_END ) != 2 || rng_START < 0 || rng_END < 0 ) usage();
+					/* was the length; a range past INT64_MAX ends there. */
+					if ( rng_END > INT64_MAX - rng_START ) rng_END = INT64_MAX;
+					else rng_END += rng_START;
+					rng_MODE = 1;
+					mode = DECOMPRESS;
+					break;
+				case 'm':
+					if ( argv[n][2] != 0 ) usage();
+					mtf_MODE = 1;
+					break;
+				case 't':
+					if ( argv[n][2] < '0' || argv[n][2] > '3' || argv[n][3] != 0 ) usage();
+					simd_TIER = argv[n][2] - '0';
+					break;
 				case 'd':
 					if ( argv[n][2] != 0 || mode == COMPRESS ) usage();
 					mode = DECOMPRESS;
@@ -140,99 +579,75 @@ int main( int argc, char *argv[] )
 		++n;
 	}
 	if ( in_argn == 0 || out_argn == 0 ) usage();
+	if ( mode == -1 ) mode = COMPRESS;  /* only -t or -m. */
 	
 	init_buffer_sizes( (1<<20) );
 	
-	if ( (gIN = fopen(argv[ in_argn ], "rb")) == NULL ) {
+	if ( strcmp( argv[ in_argn ], "-" ) == 0 ) {
+		gIN = stdin;
+		set_binary( stdin );
+	}
+	else if ( (gIN = fopen(argv[ in_argn ], "rb")) == NULL ) {
 		fprintf(stderr, "\nError opening input file.");
 		return 0;
 	}
-	if ( (pOUT = fopen(argv[ out_argn ], "wb")) == NULL ) {
+	/* the decoder of long matches reads its output back; in a batch,
+		the outfile is the suffix of the output names. */
+	if ( batch_MODE ) pOUT = NULL;
+	else if ( strcmp( argv[ out_argn ], "-" ) == 0 ) {
+		pOUT = stdout;
+		set_binary( stdout );
+	}
+	else if ( (pOUT = fopen(argv[ out_argn ], mode == DECOMPRESS ? "w+b" : "wb")) == NULL ) {
 		fprintf(stderr, "\nError opening output file." );
 		return 0;
 	}
-	init_put_buffer();
-	
 	if ( mode == COMPRESS ){
 		/* initialize */
 		win_BUFSIZE  = 1<<num_POS_BITS;   /* must be a power of 2. */
 		win_MASK     = win_BUFSIZE-1;
-		hash_SHIFT   = num_POS_BITS-8;
+		if ( hash_BITS == 0 ) hash_BITS = num_POS_BITS < MAX_HASH_BITS ? num_POS_BITS : MAX_HASH_BITS;
+		hash_SHIFT   = 32-hash_BITS;
 		pat_BUFSIZE  = win_BUFSIZE;    /* must be a power of 2. */
 		pat_MASK     = pat_BUFSIZE-1;
 		
-		/* Write the FILE STAMP. */
-		strcpy( fstamp.algorithm, "LZUF" );
-		fstamp.num_pos_bits = num_POS_BITS;
-		fstamp.file_size = 0;  /* initial write. */
-		fwrite( &fstamp, sizeof(file_stamp), 1, pOUT );
-		nbytes_out = sizeof(file_stamp);
+		/* long matches read the input file again, and a restart
+			point is not reached by them. */
+		if ( (gIN == stdin && !batch_MODE) || seek_MODE ) ldm_MODE = 0;
+		if ( mtf_MODE ) {
+			/* the bitstream of lzuf622. */
+			fmt_PROF = FMT_STREAM;
+			lit_RUNS = rep_MODE = ldm_MODE = 0;
+		}
+		if ( fmt_PROF == FMT_BYTE ) lit_RUNS = rep_MODE = 0;  /* always runs. */
+		if ( fmt_PROF == FMT_STREAM ) ldm_MODE = sum_MODE = seek_MODE = 0;  /* block-framed only. */
 		
 		fprintf(stderr, "\nWindow Buffer size used  = %15lu bytes", (ulong) win_BUFSIZE );
 		fprintf(stderr, "\nLook-Ahead Buffer size   = %15lu bytes", (ulong) pat_BUFSIZE );
+		fprintf(stderr, "\nSIMD kernels             = %15s", simd_NAME[ simd_init( simd_TIER ) ] );
+		fprintf(stderr, "\nDialect                  = %s", dialect_name( mtf_MODE ? LZUF_MTF : LZUF_RAW ) );
 		fprintf(stderr, "\n\nName of input file : %s", argv[ in_argn ] );
 		
 		/* start Compressing to output file. */
 		fprintf(stderr, "\n Compressing...");
 		
-		/* allocate memory for the window and pattern buffers. */
-		alloc_buffers();
-		
-		/* initialize sliding-window. */
-		memset( win_buf, 0, win_BUFSIZE );
-		
-		/* initialize the table of pointers. */
-		if ( !alloc_lzhash(win_BUFSIZE) ) goto halt_prog;
-		
-		/* initialize the search list. */
-		for ( i = 0; i < win_BUFSIZE; i++ ) {
-			insert_lznode( hash(win_buf,i,win_MASK,win_MASK), i );
-		}
-		
-		/* fill the pattern buffer. */
-		buf_cnt = fread( pattern, 1, pat_BUFSIZE, gIN );
-		
-		/* initialize the input buffer. */
-		init_get_buffer();
-		nbytes_read = buf_cnt;
-		
-		compress( win_buf, pattern );
+		if ( !init_coder() ) goto halt_prog;
+		if ( batch_MODE ) compress_batch( argv[ out_argn ] );
+		else if ( !compress_input( argv[ in_argn ] ) ) goto halt_prog;
 		fprintf(stderr, "complete.");
 	}
 	else if ( mode == DECOMPRESS ){
 		fprintf(stderr, "\n Name of input  file : %s", argv[in_argn] );
 		fprintf(stderr, "\n Name of output file : %s", argv[out_argn] );
 		fprintf(stderr, "\n\n  Decompressing...");
-		fread( &fstamp, sizeof(file_stamp), 1, gIN );
-		init_get_buffer();
-		nbytes_read = sizeof(file_stamp);
-		
-		/* initialize */
-		num_POS_BITS = fstamp.num_pos_bits;
-		win_BUFSIZE  = 1<<num_POS_BITS;   /* must be a power of 2. */
-		win_MASK     = win_BUFSIZE-1;
-		pat_BUFSIZE  = win_BUFSIZE;    /* must be a power of 2. */
-		
-		/* allocate memory for the window and pattern buffers. */
-		alloc_buffers();
-		
-		/* initialize sliding-window. */
-		memset( win_buf, 0, win_BUFSIZE );
-		
-		decompress( win_buf, pattern );
+		if ( !decode_file( argv[ in_argn ] ) ) goto halt_prog;
 		fprintf( stderr, "done.\n" );
 	}
-	flush_put_buffer();
-	
-	/* get infile's size and get compression ratio. */
-	nbytes_read = get_nbytes_read();
 	
+	/* get the compression ratio. */
 	if ( mode == COMPRESS ){
-		/* re-Write the FILE STAMP. */
-		rewind( pOUT );
-		fstamp.file_size = nbytes_read; /* actual input file length. */
-		fwrite( &fstamp, sizeof(file_stamp), 1, pOUT );
-		fprintf(stderr, "\nName of output file: %s", argv[ out_argn ] );
+		if ( batch_MODE ) fprintf(stderr, "\nFiles coded              = %15u (%u failed)", batch_N, batch_FAIL );
+		else fprintf(stderr, "\nName of output file: %s", argv[ out_argn ] );
 		fprintf(stderr, "\nLength of input file     = %15llu bytes", nbytes_read );
 		fprintf(stderr, "\nLength of output file    = %15llu bytes", nbytes_out );
 		
@@ -249,16 +664,24 @@ int main( int argc, char *argv[] )
 	free_put_buffer();
 	free_get_buffer();
 	free_lzhash();
-	if ( win_buf ) free( win_buf );
-	if ( pattern ) free( pattern );
-	fclose( gIN );
-	fclose( pOUT );
+	free_mtf_table();
+	big_free( lzhash8, sizeof(int) * (1<<hash_BITS) );
+	free_blocks();
+	big_free( ldm_TABLE, sizeof(ldm_t) << LDM_BITS );
+	big_free( seek_TAB, sizeof(int64_t) * 2 * seek_MAX );
+	if ( ldm_FILE ) fclose( ldm_FILE );
+	big_free( win_buf, win_BUFSIZE+HASH8_BYTES_N-1 );
+	big_free( pattern, pat_BUFSIZE+HASH8_BYTES_N-1 );
+	arena_close();
+	if ( gIN ) fclose( gIN );
+	if ( pOUT ) fclose( pOUT );
 	if ( mode == DECOMPRESS ) nbytes_read = nbytes_out;
 	fprintf(stderr, " in %3.2f secs (@ %3.2f MB/s)",
 		(double)(clock()-start_time) / CLOCKS_PER_SEC, (nbytes_read/1048576)/((double)(clock()-start_time)/ CLOCKS_PER_SEC) );
 	copyright();
 	return 0;
 }
+#endif
 
 void copyright( void )
 {
@@ -267,49 +690,452 @@ void copyright( void )
 
 void alloc_buffers( void )
 {
-	/* allocate memory for the window and pattern buffers. */
-	win_buf = (unsigned char *) malloc( sizeof(unsigned char) * win_BUFSIZE );
+	/* allocate memory for the window and pattern buffers, and
+		their mirrored bytes; the window starts zero-filled. */
+	win_buf = (unsigned char *) big_alloc( win_BUFSIZE+HASH8_BYTES_N-1 );
 	if ( !win_buf ) {
 		fprintf(stderr, "\nError alloc: window buffer.");
 		exit (0);
 	}
-	pattern = (unsigned char *) malloc( sizeof(unsigned char) * pat_BUFSIZE );
+	pattern = (unsigned char *) big_alloc( pat_BUFSIZE+HASH8_BYTES_N-1 );
 	if ( !pattern ) {
 		fprintf(stderr, "\nError alloc: pattern buffer.");
 		exit (0);
 	}
 }
 
+/* the i/o buffers, and the MTF list, of the coder and the decoder. */
+static inline size_t io_size( void )
+{
+	return arena_round(pBUFSIZE) + arena_round(gBUFSIZE)
+		+ arena_round(sizeof(mtf_list_t) * MTF_SIZE);
+}
+
+static inline void alloc_io( void )
+{
+	set_put_buffer( (unsigned char *) big_alloc( pBUFSIZE ), pBUFSIZE );
+	set_get_buffer( (unsigned char *) big_alloc( gBUFSIZE ), gBUFSIZE );
+	set_mtf_table( (mtf_list_t *) big_alloc( sizeof(mtf_list_t) * MTF_SIZE ), MTF_SIZE );
+}
+
+/* the bytes of the arena of the coder, with the parameters set; as
+	init_coder() allocates them. */
+size_t coder_size( void )
+{
+	size_t n = arena_round(win_BUFSIZE+HASH8_BYTES_N-1) + arena_round(pat_BUFSIZE+HASH8_BYTES_N-1);
+	size_t node = num_POS_BITS <= 16 && hash_BITS <= 16 ? sizeof(uint16_t) : sizeof(int);
+	
+	n += io_size();
+	n += arena_round(node << hash_BITS) + 3 * arena_round(node * win_BUFSIZE);
+	n += arena_round(sizeof(int) << hash_BITS);
+	blk_SIZE = 1<<BLOCK_BITS;
+	if ( blk_SIZE > win_BUFSIZE ) blk_SIZE = win_BUFSIZE;
+	n += arena_round(sizeof(seq_t) * (blk_SIZE/MIN_LEN+1))
+		+ arena_round(blk_SIZE > LIT_RUN_MAX ? blk_SIZE : LIT_RUN_MAX)
+		+ arena_round(2*blk_SIZE+64) + 3 * arena_round(blk_SIZE+64);
+	if ( ldm_MODE ) n += arena_round(sizeof(ldm_t) << LDM_BITS) + 2 * arena_round(LDM_CHUNK);
+	return n;
+}
+
+/*
+Allocates the buffers and tables of the coder, once for all its
+inputs, in one arena; returns 0 if they are not there.
+*/
+int init_coder( void )
+{
+	if ( !arena_open( coder_size() ) ) {
+		fprintf(stderr, "\nError alloc: %llu bytes for the coder.", (unsigned long long) coder_size() );
+		return 0;
+	}
+	alloc_io();
+	
+	/* allocate memory for the window and pattern buffers. */
+	alloc_buffers();
+	
+	/* allocate the table of pointers; a position joins the search
+		list only once it is written, so the list starts empty. */
+	lz_NARROW = num_POS_BITS <= 16 && hash_BITS <= 16;
+	if ( lz_NARROW ) {
+		if ( !alloc_lzhash_lazy16(1<<hash_BITS, win_BUFSIZE) ) return 0;
+	}
+	else if ( !alloc_lzhash_lazy(1<<hash_BITS, win_BUFSIZE) ) return 0;
+	lzhash8 = (int *) big_alloc( sizeof(int) * (1<<hash_BITS) );
+	if ( !lzhash8 ) {
+		fprintf(stderr, "\nError alloc: 8-byte hash table.");
+		return 0;
+	}
+	alloc_blocks();  /* for lit_buf, in FMT_STREAM. */
+	if ( ldm_MODE ) ldm_init();
+	return 1;
+}
+
+/* the bytes of the arena of the decoder, with the stamp read. */
+size_t decoder_size( void )
+{
+	size_t n = io_size();
+	unsigned int bsize = 1<<BLOCK_BITS;
+	
+	if ( fmt_PROF == FMT_STREAM )
+		return n + arena_round(win_BUFSIZE+HASH8_BYTES_N-1) + arena_round(pat_BUFSIZE+HASH8_BYTES_N-1);
+	if ( bsize > win_BUFSIZE ) bsize = win_BUFSIZE;
+	return n + arena_round(2*win_BUFSIZE+bsize+32) + arena_round(2*bsize+64);
+}
+
+/*
+Allocates the buffers of the decoder in one arena: the window and
+the pattern buffer of the bitstream here, the buffers of the blocks
+in decompress_blocks(). Returns 0 if they are not there.
+*/
+int init_decoder( void )
+{
+	if ( !arena_open( decoder_size() ) ) {
+		fprintf(stderr, "\nError alloc: %llu bytes for the decoder.", (unsigned long long) decoder_size() );
+		return 0;
+	}
+	alloc_io();
+	if ( fmt_PROF == FMT_STREAM ) alloc_buffers();
+	return 1;
+}
+
+/*
+Decodes gIN, which is named name, to pOUT: the stamp says the dialect,
+the window and the format, and the decoder of these is called. A file
+with no dialect is of lzuf624, unless mtf_MODE says it is of lzuf622.
+Returns 0 if the file is not one of ours, or has a corrupt block.
+*/
+int decode_file( const char *name )
+{
+	unsigned char hdr[LZUF_STAMP_SIZE] = { 0 };
+	int ok = 1;
+	
+	fread( hdr, LZUF_STAMP_SIZE, 1, gIN );
+	get_stamp( hdr, &fstamp );
+	
+	/* the decoder of the dialect; an older file has none, and
+		is of lzuf624 unless -m says it is of lzuf622. */
+	switch ( stamp_dialect( &fstamp ) ) {
+		case LZUF_LEGACY: break;
+		case LZUF_RAW: mtf_MODE = 0; break;
+		case LZUF_MTF: mtf_MODE = 1; break;
+		default:
+			fprintf(stderr, "\nError: not an LZUF file, or of a newer version.");
+			return 0;
+	}
+	if ( mtf_MODE && fstamp.format != FMT_STREAM ) {
+		fprintf(stderr, "\nError: a block-framed file has no MTF literals (-m).");
+		return 0;
+	}
+	
+	/* initialize */
+	num_POS_BITS = fstamp.num_pos_bits;
+	if ( num_POS_BITS < 12 || num_POS_BITS > MAX_POS_BITS ) {
+		fprintf(stderr, "\nError: bad window size in file stamp.");
+		return 0;
+	}
+	fmt_PROF = fstamp.format & FMT_MASK;
+	lit_RUNS = (fstamp.format & FMT_LITRUNS) != 0;
+	rep_MODE = (fstamp.format & FMT_REPS) != 0;
+	ldm_MODE = (fstamp.format & FMT_LONG) != 0;
+	sum_MODE = (fstamp.format & FMT_CHECKSUM) != 0;
+	eos_MODE = (fstamp.format & FMT_EOS) != 0;
+	if ( eos_MODE ) fstamp.file_size = INT64_MAX;  /* up to the end code. */
+	if ( ldm_MODE && pOUT == stdout ) {
+		fprintf(stderr, "\nError: long matches (-l) cannot be decoded to stdout.");
+		return 0;
+	}
+	seek_MODE = (fstamp.format & FMT_SEEK) != 0;
+	win_BUFSIZE  = 1<<num_POS_BITS;   /* must be a power of 2. */
+	win_MASK     = win_BUFSIZE-1;
+	pat_BUFSIZE  = win_BUFSIZE;    /* must be a power of 2. */
+	
+	/* a range is read from the restart point before it, or
+		decoded from the start if the file has none (or cannot seek). */
+	if ( rng_MODE && (fmt_PROF == FMT_STREAM || ldm_MODE) ) {
+		fprintf(stderr, "\nError: --range needs a block-framed file with no long matches.");
+		return 0;
+	}
+	if ( !init_decoder() ) return 0;
+	init_put_buffer();
+	init_get_buffer();
+	nbytes_read = LZUF_STAMP_SIZE;
+	win_cnt = 0;
+	
+	if ( fmt_PROF == FMT_STREAM ) decompress( win_buf, pattern );
+	else if ( rng_MODE && seek_MODE && gIN != stdin ) read_range( name );
+	else if ( !decompress_blocks() ) ok = 0;
+	flush_put_buffer();
+	nbytes_read = get_nbytes_read();
+	return ok;
+}
+
+/*
+Readies the coder for the next input, keeping what it has allocated:
+the hash lists are emptied by lz_FILL = 0, the 8-byte hash table by
+a new generation, and the long-match table by ldm_BASE; so an input
+is coded the same in a batch as alone. Only the window of the
+bitstream is cleared, since its matches may reach the zero-filled
+window before the input.
+*/
+void reset_coder( void )
+{
+	if ( coder_USED ) {
+		lz_FILL = 0;
+		if ( ++lz8_GEN > LZ8_GEN_MAX ) {
+			memset( lzhash8, 0, sizeof(int) * (1<<hash_BITS) );
+			lz8_GEN = 1;
+		}
+		ldm_BASE += in_POS;
+		/* the window is zero-filled, as at the start: all of it for the
+			bitstream, whose matches may reach into it; the blocks only
+			wrote their content (in_POS bytes) into it. */
+		if ( fmt_PROF == FMT_STREAM || in_POS >= win_BUFSIZE )
+			memset( win_buf, 0, win_BUFSIZE+HASH8_BYTES_N-1 );
+		else {
+			memset( win_buf, 0, (size_t) in_POS );
+			memset( win_buf+win_BUFSIZE, 0, HASH8_BYTES_N-1 );
+		}
+		if ( mtf_MODE ) init_mtf();
+	}
+	coder_USED = 1;
+	win_cnt = pat_cnt = buf_cnt = 0;
+	len_CODE = 0;
+	dpos.pos = dpos.len = 0;
+	lit_cnt = 0;
+	blk_left = INT_MAX;
+	hist_CNT = 0;
+	in_POS = 0;
+	ldm_HASH = 0;
+	ldm_NEXT = ldm_FED = 0;
+	ldm_LEN = 0;
+	seek_N = 0;
+	eos_MODE = 0;
+}
+
+/*
+Codes gIN to pOUT, with the buffers and tables of init_coder(); name
+is the input file, which long matches read again. Returns 0 on an error.
+*/
+int compress_input( const char *name )
+{
+	unsigned char hdr[LZUF_STAMP_SIZE];
+	
+	reset_coder();
+	init_put_buffer();
+	
+	/* Write the FILE STAMP. */
+	set_stamp( &fstamp, mtf_MODE ? LZUF_MTF : LZUF_RAW );
+	fstamp.num_pos_bits = num_POS_BITS;
+	
+	/* the content size goes up front, if the input can seek;
+		otherwise the content ends in-band. */
+	if ( fseeko( gIN, 0, SEEK_END ) == 0 ) {
+		fstamp.file_size = ftello( gIN );
+		fseeko( gIN, 0, SEEK_SET );
+	}
+	else eos_MODE = 1;
+	if ( eos_MODE && mtf_MODE ) {
+		fprintf(stderr, "\nError: -m needs an input of known size.");
+		return 0;
+	}
+	fstamp.format = fmt_PROF | (lit_RUNS ? FMT_LITRUNS : 0) | (rep_MODE ? FMT_REPS : 0)
+		| (ldm_MODE ? FMT_LONG : 0) | (sum_MODE ? FMT_CHECKSUM : 0) | (eos_MODE ? FMT_EOS : 0)
+		| (seek_MODE ? FMT_SEEK : 0);
+	put_stamp( hdr, &fstamp );
+	fwrite( hdr, LZUF_STAMP_SIZE, 1, pOUT );
+	nbytes_out = LZUF_STAMP_SIZE;
+	
+	/* fill the pattern buffer. */
+	buf_cnt = fread( pattern, 1, pat_BUFSIZE, gIN );
+	mirror( pattern, pat_BUFSIZE );
+	
+	/* initialize the input buffer. */
+	init_get_buffer();
+	nbytes_read = buf_cnt;
+	
+	if ( fmt_PROF == FMT_STREAM ) compress( win_buf, pattern );
+	else {
+		if ( ldm_MODE && (ldm_FILE = fopen(name, "rb")) == NULL ) {
+			fprintf(stderr, "\nError opening input file.");
+			return 0;
+		}
+		compress_blocks( win_buf, pattern );
+		if ( ldm_FILE ) fclose( ldm_FILE );
+		ldm_FILE = NULL;
+	}
+	flush_put_buffer();
+	
+	/* get infile's size. */
+	nbytes_read = get_nbytes_read();
+	
+	/* re-Write the FILE STAMP, if the input was not the size it had. */
+	if ( !eos_MODE && fstamp.file_size != nbytes_read ) {
+		if ( fseeko( pOUT, 0, SEEK_SET ) != 0 ) {
+			fprintf(stderr, "\nError: the input changed size; the output is not valid.");
+			return 0;
+		}
+		fstamp.file_size = nbytes_read; /* actual input file length. */
+		put_stamp( hdr, &fstamp );
+		fwrite( hdr, LZUF_STAMP_SIZE, 1, pOUT );
+	}
+	return 1;
+}
+
+/*
+Codes each file named in the list gIN to its name + suffix, with
+one coder; a file that cannot be opened or coded is reported, and
+the batch goes on. nbytes_read and nbytes_out are the totals.
+*/
+void compress_batch( const char *suffix )
+{
+	FILE *list = gIN;
+	char *name, *out;
+	size_t n, k = strlen( suffix );
+	int64_t total_in = 0, total_out = 0;
+	
+	name = (char *) malloc( FILENAME_MAX+1 );
+	out = (char *) malloc( FILENAME_MAX+k+1 );
+	if ( !name || !out ) {
+		fprintf(stderr, "\nError alloc: file names.");
+		exit (0);
+	}
+	while ( fgets( name, FILENAME_MAX+1, list ) ) {
+		n = strlen( name );
+		while ( n > 0 && (name[n-1] == '\n' || name[n-1] == '\r') ) name[--n] = 0;
+		if ( n == 0 ) continue;
+		memcpy( out, name, n );
+		memcpy( out+n, suffix, k+1 );
+		if ( (gIN = fopen(name, "rb")) == NULL || (pOUT = fopen(out, "wb")) == NULL ) {
+			fprintf(stderr, "\nError opening file: %s", gIN ? out : name );
+			batch_FAIL++;
+		}
+		else if ( !compress_input( name ) ) {
+			fprintf(stderr, " (%s)", name );
+			batch_FAIL++;
+		}
+		else {
+			batch_N++;
+			total_in += nbytes_read;
+			total_out += nbytes_out;
+		}
+		if ( gIN ) fclose( gIN );
+		if ( pOUT ) fclose( pOUT );
+		pOUT = NULL;
+	}
+	if ( list != stdin ) fclose( list );
+	gIN = NULL;
+	nbytes_read = total_in;
+	nbytes_out = total_out;
+	free( name );
+	free( out );
+}
+
 void compress( unsigned char *w, unsigned char *p )
 {
+	unsigned int misses = 0, skip, back;
+	
+	init_reps( rep_DIST );
+	
 	/* compress */
 	while ( buf_cnt > 0 ) {  /* look-ahead buffer not empty? */
 		search( w, p );
 		
+		/* the step grows with the number of misses in a row. */
+		if ( dpos.len < MIN_LEN ) skip = (++misses * a_ACCEL) >> SKIP_TRIGGER;
+		else misses = skip = 0;
+		
+		if ( dpos.len < MIN_LEN ) {
+			/* hold the literal back until the next match. */
+			lit_buf[lit_cnt++] = p[pat_cnt];
+			dpos.len = 1;
+			slide( w, p );
+			if ( lit_cnt == LIT_RUN_MAX ) put_literals();
+			if ( skip ) skip_literals( w, p, skip );
+			continue;
+		}
+		
+		/* the match takes over the held-back literals that it extends to. */
+		back = 0;
+		if ( lit_cnt ) {
+			back = extend_back( w, lit_cnt, ((win_cnt-dpos.pos-1) & win_MASK) + 1, dpos.len );
+			lit_cnt -= back;
+			if ( lit_cnt ) put_literals();
+			dpos.pos = (dpos.pos-back) & win_MASK;
+			dpos.len += back;
+		}
+		
 		/* encode prefix bits. */
 		if ( dpos.len > MIN_LEN ) { /* more than MIN_LEN match? */
 			put_ONE();            /* yes, send a 1 bit. */
 		}
-		else if ( dpos.len == MIN_LEN ) { /* exactly MIN_LEN matching characters? */
-			put_ZERO();          /* yes, send a 0 bit. */
-			put_ONE();           /* and a 1 bit. */
-		}
-		else {                  /* less than MIN_LEN matching characters. */
+		else {                    /* exactly MIN_LEN matching characters. */
 			put_ZERO();          /* send a 0 bit. */
-			put_ZERO();          /* one more 0 bit to indicate a no match. */
+			put_ONE();           /* and a 1 bit. */
 		}
 
-		/* encode window position or len codes. */
-		put_codes( w, p );
+		/* encode window position and len codes. */
+		put_codes( w, p, back );
+		if ( skip ) skip_literals( w, p, skip );
+	}
+	if ( lit_cnt ) put_literals();
+	
+	/* the end code: a MIN_LEN match at the window position being written. */
+	if ( eos_MODE ) {
+		put_ZERO();
+		put_ONE();
+		if ( rep_MODE ) put_ZERO();
+		put_nbits( win_cnt, num_POS_BITS );
 	}
 }
 
-void decompress( unsigned char *w, unsigned char *p )
+/* codes the next n bytes as literals, with no search and no hashing. */
+static inline void skip_literals( unsigned char *w, unsigned char *p, unsigned int n )
+{
+	unsigned int i;
+	
+	if ( n > buf_cnt ) n = buf_cnt;
+	for ( i = 0; i < n; i++ ) {
+		lit_buf[lit_cnt++] = p[(pat_cnt+i) & pat_MASK];
+		if ( lit_cnt == LIT_RUN_MAX ) put_literals();
+	}
+	slide_raw( w, p, n, 0 );
+}
+
+/* the held-back literals: a literal run (the 00 prefix, the run
+	length and the bytes), or the 00 prefix and each byte; a byte is
+	its 8 bits, or its VL-coded MTF rank in the MTF dialect. */
+static inline void put_literals( void )
+{
+	unsigned int i;
+	
+	if ( lit_RUNS ) {
+		put_ZERO();
+		put_ZERO();
+		put_vlcode( lit_cnt-1, LIT_RUN_BITS );
+	}
+	for ( i = 0; i < lit_cnt; i++ ) {
+		if ( !lit_RUNS ) {
+			put_ZERO();
+			put_ZERO();
+		}
+		if ( mtf_MODE ) put_vlcode( mtf(lit_buf[i]), 3 );
+		else put_nbits( lit_buf[i], 8 );
+	}
+	lit_cnt = 0;
+}
+
+/*
+The FMT_STREAM decoder, for a window of wb bits, literal runs (runs),
+repeat distances (reps) and MTF-coded literals (mtfl); see DECODERS.
+*/
+KERNEL void decompress_k( unsigned char *w, unsigned char *p,
+	const int wb, const int runs, const int reps, const int mtfl )
 {
+	const unsigned int mask = (1u << wb) - 1;
 	int i, k;
 	int64_t fsize;
 	
 	fsize = fstamp.file_size;
+	init_reps( rep_DIST );
 	while ( fsize ) {
 		if ( get_bit() == 1 ){
 			/* get length. */
@@ -319,31 +1145,43 @@ void decompress( unsigned char *w, unsigned char *p )
 			len_CODE += get_nbits(MFOLD);
 			
 			/* get position. */
-			dpos.pos = get_nbits( num_POS_BITS );
+			dpos.pos = get_pos( wb, reps );
 			dpos.len = len_CODE + (MIN_LEN+1);  /* actual length. */
 			
 			/* if its a match, then "slide" the window buffer. */
 			i = dpos.len;
 			while ( i-- ) {
 				/* copy byte. */
-				p[i] = w[ (dpos.pos+i) & win_MASK ];
+				p[i] = w[ (dpos.pos+i) & mask ];
 			}
 			i = 0;
 			while ( i < dpos.len ) {
-				w[ (win_cnt+i) & win_MASK ] = p[i];  /* update window */
+				w[ (win_cnt+i) & mask ] = p[i];  /* update window */
 				pfputc( p[i++] );  /* output byte. */
 			}
 			fsize -= dpos.len;
-			win_cnt = (win_cnt + dpos.len) & win_MASK;
+			win_cnt = (win_cnt + dpos.len) & mask;
 		}
 		else {
 			switch ( get_bit() ){
 			case 0:
 			
+			if ( runs ) {
+				/* get a run of bytes and output it. */
+				i = get_vlcode( LIT_RUN_BITS ) + 1;
+				fsize -= i;
+				while ( i-- ) {
+					k = mtfl ? get_mtf_c(get_vlcode(3)) : get_nbits(8);
+					pfputc( w[ win_cnt ] = k );
+					if ( (++win_cnt) == (1 << wb) ) win_cnt = 0;
+				}
+				break;
+			}
+			
 			/* get byte and output it. */
-			k = get_nbits(8);
-			pfputc( w[ (win_cnt) & win_MASK ] = k );
-			if ( (++win_cnt) == win_BUFSIZE ) win_cnt = 0;
+			k = mtfl ? get_mtf_c(get_vlcode(3)) : get_nbits(8);
+			pfputc( w[ (win_cnt) & mask ] = k );
+			if ( (++win_cnt) == (1 << wb) ) win_cnt = 0;
 			--fsize;
 			
 			break;
@@ -351,22 +1189,33 @@ void decompress( unsigned char *w, unsigned char *p )
 			case 1:
 
 			/* get position. */
-			dpos.pos = get_nbits( num_POS_BITS );
+			dpos.pos = get_pos( wb, reps );
 			dpos.len = MIN_LEN;
+			if ( eos_MODE && dpos.pos == win_cnt ) {
+				fsize = 0;  /* the end code. */
+				break;
+			}
 			
 			/* if its a match, then "slide" the window buffer. */
 			i = dpos.len;
 			while ( i-- ) {
 				/* copy byte. */
-				p[i] = w[ (dpos.pos+i) & win_MASK ];
+				p[i] = w[ (dpos.pos+i) & mask ];
 			}
 			i = 0;
 			while ( i < dpos.len ) {
-				w[ (win_cnt+i) & win_MASK ] = p[i];  /* update window */
+				w[ (win_cnt+i) & mask ] = p[i];  /* update window */
 				pfputc( p[i++] );  /* output byte. */
 			}
 			fsize -= dpos.len;
-			win_cnt = (win_cnt + dpos.len) & win_MASK;
+			win_cnt = (win_cnt + dpos.len) & mask;
+			
+			break;
+			
+			default:
+			
+			fprintf(stderr, "\nError: unexpected end of input.");
+			fsize = 0;
 			
 			break;
 			}	/* end switch */
@@ -387,48 +1236,116 @@ Note:
 	We output 2 bits for a string of size MIN_LEN, so in terms of 
 	the transmitted length code, MINIMUM_MATCH_LENGTH is actually 
 	prev_LEN = (MIN_LEN+1) here, not MIN_LEN.
+
+	In the block-framed formats a match is coded as a distance and
+	decoded by a forward copy, so a match must lie in the real history
+	and end before the current position: there it is limited to its
+	distance d.
 */
+/* tries the candidate at window position i; returns 1 on a longer match. */
+static inline int match_at( unsigned char *w, unsigned char *p, int i, int lim )
+{
+	int j, k, max_k = lim;
+	unsigned int d, n, m;
+	
+	if ( blk_MODE ) {
+		d = ((win_cnt-i-1) & win_MASK) + 1;
+		if ( d > hist_CNT ) return 0;
+		if ( d < max_k ) max_k = d;
+	}
+	else if ( eos_MODE && i == win_cnt ) return 0;  /* the end code. */
+	if ( max_k <= dpos.len ) return 0;
+	j = (pat_cnt+dpos.len) & pat_MASK;
+	k = dpos.len;
+	do {
+		if ( p[j] != w[ (i+k) & win_MASK ] ) {
+			return 0;  /* allows fast search. */
+		}
+		if ( j-- == 0 ) j=pat_BUFSIZE-1;
+	} while ( (--k) >= 0 );
+
+	/* then match the rest of the "suffix" string from left to right:
+		most matches end in a few bytes; a longer one is compared by
+		match_len(), in the pieces that do not wrap around either buffer. */
+	k = dpos.len+1;
+	n = k+SHORT_EXT < max_k ? k+SHORT_EXT : max_k;
+	j = (pat_cnt+k) & pat_MASK;
+	while ( k < n && p[j] == w[ (i+k) & win_MASK ] ) {
+		j = (j+1) & pat_MASK;
+		k++;
+	}
+	if ( k == n ) while ( k < max_k ) {
+		j = (pat_cnt+k) & pat_MASK;
+		d = (i+k) & win_MASK;
+		n = max_k-k;
+		if ( n > pat_BUFSIZE-j ) n = pat_BUFSIZE-j;
+		if ( n > win_BUFSIZE-d ) n = win_BUFSIZE-d;
+		m = match_len( p+j, w+d, n );
+		k += m;
+		if ( m < n ) break;
+	}
+
+	/* greater than previous length, record it. */
+	dpos.pos = i;
+	dpos.len = k;
+	return 1;
+}
+
+/* walks the list from position i; one instance for each size of list node. */
+#define SEARCH_LIST(name, lz_next) \
+static inline void name( unsigned char *w, unsigned char *p, int i, int lim ) \
+{ \
+	int m = 0; \
+	\
+	while ( i != LZ_NULL ) { \
+		/* maximum match, end the search. */ \
+		if ( match_at( w, p, i, lim ) && dpos.len == lim ) break; \
+		\
+		if ( ++m == far_LIST ) break; \
+		\
+		/* point to next occurrence of this hash index. */ \
+		i = lz_next( i ); \
+	} \
+}
+
+SEARCH_LIST( search_list, lz_next )
+SEARCH_LIST( search_list16, lz_next16 )
+
 static inline void search( unsigned char *w, unsigned char *p )
 {
-	int i, j, k, m = 0, n = 0;
+	int i, lim = buf_cnt;
+	dpos_t r;
 	
 	dpos.pos = 0;
 	dpos.len = 0;
 	
-	/* point to start of lzhash[ index ] */
-	i = lzhash[ hash(p,pat_cnt,pat_MASK,win_MASK) ];
+	/* matches do not cross a block boundary. */
+	if ( blk_left < lim ) lim = blk_left;
+	if ( lim <= 1 ) return;
 	
-	if ( buf_cnt > 1 ) while ( i != LZ_NULL ) {
-		j = (pat_cnt+dpos.len) & pat_MASK;
-		k = dpos.len;
-		do {
-			if ( p[j] != w[ (i+k) & win_MASK ] ) {
-				goto skip_search;  /* allows fast search. */
-			}
-			if ( j-- == 0 ) j=pat_BUFSIZE-1;
-		} while ( (--k) >= 0 );
-
-		/* then match the rest of the "suffix" string from left to right. */
-		j = (pat_cnt+dpos.len+1) & pat_MASK;
-		k = dpos.len+1;
-		if ( k < buf_cnt )
-			while ( p[ j++ & pat_MASK ] == w[ (i+k) & win_MASK ]
-				&& (++k) < buf_cnt ) ;
-
-		/* greater than previous length, record it. */
-		dpos.pos = i;
-		dpos.len = k;
-		
-		/* maximum match, end the search. */
-		if ( k == buf_cnt ) break;
-		
-		skip_search:
-		
-		if ( ++m == far_LIST ) break;
-
-		/* point to next occurrence of this hash index. */
-		i = lznext[i];
+	/* the repeat distances first; a long match there ends the search. */
+	if ( rep_MODE ) {
+		for ( i = 0; i < REP_N; i++ ) {
+			match_at( w, p, (win_cnt-rep_DIST[i]) & win_MASK, lim );
+		}
+		if ( dpos.len >= LONG_MATCH || dpos.len == lim ) return;
+		r = dpos;
 	}
+	
+	/* the 8-byte hash finds a long match first; the list then
+		only has to improve on it. */
+	if ( lim >= HASH8_BYTES_N ) {
+		i = lzhash8[ hash8(p,pat_cnt) ] ^ (lz8_GEN << MAX_POS_BITS);
+		if ( (unsigned int) i < (unsigned int) lz_FILL && match_at( w, p, i, lim )
+			&& (dpos.len >= LONG_MATCH || dpos.len == lim) ) return;
+	}
+	
+	/* point to start of lzhash[ index ] */
+	if ( lz_NARROW ) search_list16( w, p, lz_head16( hash(p,pat_cnt) ), lim );
+	else search_list( w, p, lz_head( hash(p,pat_cnt) ), lim );
+	
+	/* a repeat distance is cheaper than one more byte of match. */
+	if ( rep_MODE && r.len >= MIN_LEN && dpos.len <= r.len+1 ) dpos = r;
 }
 
 /*
@@ -448,11 +1365,12 @@ copying the matched characters to the window buffer; note that
 the linked list is also updated.
 
 Finally, it "gets" characters from the input file according
-to the number of matching characters.
+to the number of matching characters. A match that was extended
+backward over back literals only slides over its own bytes.
 */
-static inline void put_codes( unsigned char *w, unsigned char *p )
+static inline void put_codes( unsigned char *w, unsigned char *p, unsigned int back )
 {
-	int i, k;
+	int k;
 	
 	/* the whole string match is encoded completely. (Oct. 19, 2008) */
 	if ( dpos.len > MIN_LEN ) {
@@ -465,6 +1383,18 @@ static inline void put_codes( unsigned char *w, unsigned char *p )
 	/* encode position for match len >= MIN_LEN. */
 	if ( dpos.len >= MIN_LEN ) {
 		k = dpos.pos;
+		if ( rep_MODE ) {
+			/* a repeat distance is sent as its index. */
+			if ( (k = update_reps( rep_DIST, ((win_cnt-back-k-1) & win_MASK) + 1 )) < REP_N ) {
+				put_ONE();
+				put_nbits( k, REP_BITS );
+				dpos.len -= back;
+				slide( w, p );
+				return;
+			}
+			put_ZERO();
+			k = dpos.pos;
+		}
 		put_nbits( k, num_POS_BITS );
 	}
 	else {
@@ -474,6 +1404,109 @@ static inline void put_codes( unsigned char *w, unsigned char *p )
 		put_nbits(k, 8);
 	}
 	
+	/* the window already holds the back bytes. */
+	dpos.len -= back;
+	slide( w, p );
+}
+
+/* moves position k to the list of its new hash, once it is written. */
+static inline void rehash( unsigned char *w, int k )
+{
+	if ( k >= lz_FILL ) return;
+	if ( lz_NARROW ) {
+		delete_lznode16( hashp16[k], k );
+		insert_lznode16( hash(w,k), k );
+	}
+	else {
+		delete_lznode( hashp[k], k );
+		insert_lznode( hash(w,k), k );
+	}
+}
+
+/* records the n positions from k on, every stride-th, in the 8-byte hash table. */
+static inline void rehash8( unsigned char *w, int k, int n, int stride )
+{
+	int i;
+	
+	for ( i = 0; i < n; i += stride ) {
+		lzhash8[ hash8(w,(k+i) & win_MASK) ] = ((k+i) & win_MASK) | (lz8_GEN << MAX_POS_BITS);
+	}
+}
+
+/*
+Extends a match of len bytes at distance d (1..win_BUFSIZE) backward
+over the last n literals, that are held back; returns the number of
+literals it takes over.
+
+In the block-framed formats the source must be in the real history.
+In FMT_STREAM the decoder copies a match out of the window before it
+writes it, so the source must end before the literals taken over and
+must not wrap around into them.
+*/
+static inline unsigned int extend_back( unsigned char *w, unsigned int n, unsigned int d,
+	unsigned int len )
+{
+	unsigned int e = 0;
+	
+	while ( e < n ) {
+		if ( blk_MODE ) {
+			if ( d+e+1 > hist_CNT ) break;
+		}
+		else if ( len+e+1 > d || d+e+1 > win_BUFSIZE ) break;
+		if ( w[(win_cnt-1-e) & win_MASK] != w[(win_cnt-d-1-e) & win_MASK] ) break;
+		e++;
+	}
+	return e;
+}
+
+/* the repeat distances start as 1..REP_N. */
+static inline void init_reps( unsigned int *r )
+{
+	int i;
+	
+	for ( i = 0; i < REP_N; i++ ) r[i] = i+1;
+}
+
+/*
+Moves distance d to the front of the repeat distances r; returns its
+old index, or REP_N if it was not there (the oldest one is dropped).
+*/
+static inline int update_reps( unsigned int *r, unsigned int d )
+{
+	int j, k;
+	
+	for ( j = 0; j < REP_N && r[j] != d; j++ ) ;
+	for ( k = j < REP_N ? j : REP_N-1; k > 0; k-- ) r[k] = r[k-1];
+	r[0] = d;
+	return j;
+}
+
+/* reads a position of the FMT_STREAM format. */
+KERNEL unsigned int get_pos( const int wb, const int reps )
+{
+	const unsigned int mask = (1u << wb) - 1;
+	unsigned int k;
+	
+	if ( reps ) {
+		if ( get_bit() ) {
+			k = rep_DIST[ get_nbits( REP_BITS ) ];
+			update_reps( rep_DIST, k );
+			return (win_cnt-k) & mask;
+		}
+		k = get_nbits( wb );
+		update_reps( rep_DIST, ((win_cnt-k-1) & mask) + 1 );
+		return k;
+	}
+	return get_nbits( wb );
+}
+
+/*
+Performs the "sliding" part for the dpos.len bytes just coded.
+*/
+static inline void slide( unsigned char *w, unsigned char *p )
+{
+	int i, k, n;
+	
 	/* ---- if its a match, then "slide" the buffer. ---- */
 	if ( (k=win_cnt-(HASH_BYTES_N-1)) < 0 ) {
 		/* record the left-most string index (k). */
@@ -485,11 +1518,27 @@ static inline void put_codes( unsigned char *w, unsigned char *p )
 		/* write the character to the window buffer. */
 		w[(win_cnt+i) & (win_MASK)] = p[(pat_cnt+i) & pat_MASK];
 	}
+	mirror( w, win_BUFSIZE );
+	if ( lz_FILL < win_BUFSIZE ) fill_lznodes( win_cnt+dpos.len );
 
-	/* with the new characters, rehash at this position. */
-	for ( i = 0; i < (dpos.len+(HASH_BYTES_N-1)); i++ ) {
-		delete_lznode( hashp[(k+i) & win_MASK], (k+i) & win_MASK );
-		insert_lznode( hash(w,(k+i),win_MASK,win_MASK), (k+i) & win_MASK );
+	/* with the new characters, rehash at this position; the 8-byte
+		hash lags behind, to the positions with all 8 bytes written. */
+	n = win_cnt-(HASH8_BYTES_N-1);
+	if ( i_STRIDE == 1 || dpos.len <= SPARSE_MIN ) {
+		for ( i = 0; i < (dpos.len+(HASH_BYTES_N-1)); i++ ) {
+			rehash( w, (k+i) & win_MASK );
+		}
+		rehash8( w, n, dpos.len, 1 );
+	}
+	else {
+		rehash8( w, n, dpos.len, i_STRIDE );
+		/* a long match: the skipped positions keep their old nodes. */
+		n = dpos.len+(HASH_BYTES_N-1);
+		for ( i = 0; i < n; ) {
+			rehash( w, (k+i) & win_MASK );
+			if ( i < SPARSE_HEAD-1 || i >= n-SPARSE_TAIL ) i++;
+			else if ( (i += i_STRIDE) > n-SPARSE_TAIL ) i = n-SPARSE_TAIL;
+		}
 	}
 	
 	/* get dpos.len bytes */
@@ -499,9 +1548,1552 @@ static inline void put_codes( unsigned char *w, unsigned char *p )
 		}
 		else break;
 	}
+	mirror( p, pat_BUFSIZE );
 
 	/* update counters. */
 	buf_cnt -= (dpos.len-i);
 	win_cnt = (win_cnt+dpos.len) & win_MASK;
 	pat_cnt = (pat_cnt+dpos.len) & pat_MASK;
+	if ( (hist_CNT += dpos.len) > win_BUFSIZE ) hist_CNT = win_BUFSIZE;
+}
+
+/*
+Slides the buffers over n bytes that are not searched (a stored block).
+Only every stride-th position is rehashed, none if stride is 0: the
+nodes of the other positions stay in their lists until they are
+rehashed, and search() compares the bytes of every candidate anyway.
+*/
+static inline void slide_raw( unsigned char *w, unsigned char *p, int n, int stride )
+{
+	int i, k;
+	
+	for ( i = 0; i < n; i++ ) {
+		w[(win_cnt+i) & win_MASK] = p[(pat_cnt+i) & pat_MASK];
+	}
+	mirror( w, win_BUFSIZE );
+	if ( lz_FILL < win_BUFSIZE ) fill_lznodes( win_cnt+n );
+	if ( stride ) {
+		for ( i = 0; i < n; i += stride ) {
+			rehash( w, (win_cnt+i) & win_MASK );
+		}
+		rehash8( w, win_cnt-(HASH8_BYTES_N-1), n, stride );
+	}
+	for ( i = 0; i < n; i++ ){
+		if( (k=gfgetc()) != EOF ) {
+			p[(pat_cnt+i) & pat_MASK] = (uchar) k;
+		}
+		else break;
+	}
+	mirror( p, pat_BUFSIZE );
+	buf_cnt -= (n-i);
+	win_cnt = (win_cnt+n) & win_MASK;
+	pat_cnt = (pat_cnt+n) & pat_MASK;
+	if ( (hist_CNT += n) > win_BUFSIZE ) hist_CNT = win_BUFSIZE;
+}
+
+/*
+Returns the number of bytes at the start of the look-ahead that
+repeat the last byte of the window, within the current block.
+*/
+static inline unsigned int run_length( unsigned char *w, unsigned char *p )
+{
+	unsigned int n, k, lim = buf_cnt;
+	int c;
+	
+	if ( hist_CNT == 0 ) return 0;
+	c = w[(win_cnt-1) & win_MASK];
+	if ( p[pat_cnt] != c ) return 0;
+	if ( blk_left < lim ) lim = blk_left;
+	
+	/* the pattern buffer is circular. */
+	n = pat_BUFSIZE - pat_cnt;
+	if ( n > lim ) n = lim;
+	k = run_scan( p+pat_cnt, c, n );
+	if ( k == n && n < lim ) k += run_scan( p, c, lim-n );
+	return k;
+}
+
+/*
+Slides the buffers over a run of n bytes. Only the positions that
+start before the run and the last RUN_TAIL positions of the run are
+rehashed; the others keep their old nodes.
+*/
+static inline void slide_run( unsigned char *w, unsigned char *p, int n )
+{
+	int i, c = win_cnt;
+	
+	slide_raw( w, p, n, 0 );
+	for ( i = -(HASH_BYTES_N-1); i < n; i++ ) {
+		if ( i == 0 && n > RUN_TAIL ) i = n-RUN_TAIL;
+		rehash( w, (c+i) & win_MASK );
+	}
+}
+
+/* ---- block-framed formats ---- */
+
+void alloc_blocks( void )
+{
+	int i;
+	
+	blk_SIZE = 1<<BLOCK_BITS;
+	if ( blk_SIZE > win_BUFSIZE ) blk_SIZE = win_BUFSIZE;
+	
+	seq_buf = (seq_t *) big_alloc( sizeof(seq_t) * (blk_SIZE/MIN_LEN+1) );
+	lit_buf = (unsigned char *) big_alloc( blk_SIZE > LIT_RUN_MAX ? blk_SIZE : LIT_RUN_MAX );
+	blk_buf = (unsigned char *) big_alloc( 2*blk_SIZE+64 );
+	if ( !seq_buf || !lit_buf || !blk_buf ) {
+		fprintf(stderr, "\nError alloc: block buffers.");
+		exit (0);
+	}
+	for ( i = 0; i < 3; i++ ) {
+		bm_buf[i] = (unsigned char *) big_alloc( blk_SIZE+64 );
+		if ( !bm_buf[i] ) {
+			fprintf(stderr, "\nError alloc: block buffers.");
+			exit (0);
+		}
+	}
+}
+
+void free_blocks( void )
+{
+	int i;
+	
+	big_free( seq_buf, sizeof(seq_t) * (blk_SIZE/MIN_LEN+1) );
+	big_free( lit_buf, blk_SIZE > LIT_RUN_MAX ? blk_SIZE : LIT_RUN_MAX );
+	big_free( blk_buf, 2*blk_SIZE+64 );
+	for ( i = 0; i < 3; i++ ) big_free( bm_buf[i], blk_SIZE+64 );
+	for ( i = 0; i < 2; i++ ) big_free( ldm_buf[i], LDM_CHUNK );
+}
+
+static inline void put_le32( unsigned int k )
+{
+	pfputc( k & 0xff );
+	pfputc( (k >> 8) & 0xff );
+	pfputc( (k >> 16) & 0xff );
+	pfputc( (k >> 24) & 0xff );
+}
+
+static inline unsigned int get_le32( void )
+{
+	unsigned int k;
+	
+	k  = (unsigned int) gfgetc();
+	k |= (unsigned int) gfgetc() << 8;
+	k |= (unsigned int) gfgetc() << 16;
+	k |= (unsigned int) gfgetc() << 24;
+	return k;
+}
+
+static inline void mem_le32( unsigned char *b, unsigned int k )
+{
+	b[0] = k & 0xff;
+	b[1] = (k >> 8) & 0xff;
+	b[2] = (k >> 16) & 0xff;
+	b[3] = (k >> 24) & 0xff;
+}
+
+static inline unsigned int mem_get_le32( const unsigned char *b )
+{
+	return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int) b[3] << 24);
+}
+
+/*
+Splits the sequences of a block into four streams:
+
+	flags:      the LZUF prefix bits (1, 01 or 00);
+	lengths:    the golomb codes of match lengths > MIN_LEN, and
+	            the lengths of literal runs (FMT_LITRUNS);
+	positions:  the match distances (1..win_BUFSIZE), num_POS_BITS each,
+	            or the index of a repeat distance (FMT_REPS);
+	literals:   the raw literal bytes.
+
+The block is laid out as the sizes of the first three streams
+(32-bit each), followed by the four streams. The decoder works on
+the streams with independent bit readers, and reads literals
+straight from memory.
+*/
+unsigned int put_split( unsigned int nseq, unsigned int nlit )
+{
+	bitmem_t f, l, q;
+	unsigned int i, n, fn, ln, qn, r[REP_N];
+	seq_t *s;
+	
+	bm_init_put( &f, bm_buf[0] );
+	bm_init_put( &l, bm_buf[1] );
+	bm_init_put( &q, bm_buf[2] );
+	init_reps( r );
+	for ( i = 0, s = seq_buf; i < nseq; i++, s++ ) {
+		if ( lit_RUNS ) {
+			if ( s->lit ) {
+				bm_put_nbits( &f, 0, 2 );
+				bm_put_vlcode( &l, s->lit-1, LIT_RUN_BITS );
+			}
+		}
+		else {
+			for ( n = s->lit; n >= 16; n -= 16 ) bm_put_nbits( &f, 0, 32 );
+			if ( n ) bm_put_nbits( &f, 0, 2*n );
+		}
+		if ( s->len > MIN_LEN ) {
+			bm_put_nbits( &f, 1, 1 );
+			bm_put_golomb( &l, s->len - (MIN_LEN+1), MFOLD );
+		}
+		else if ( s->len == MIN_LEN ) bm_put_nbits( &f, 2, 2 );
+		else continue;
+		if ( rep_MODE ) {
+			if ( (n = update_reps( r, s->dist )) < REP_N ) {
+				bm_put_nbits( &q, 1, 1 );
+				bm_put_nbits( &q, n, REP_BITS );
+				continue;
+			}
+			bm_put_nbits( &q, 0, 1 );
+		}
+		bm_put_nbits( &q, s->dist-1, num_POS_BITS );
+	}
+	fn = bm_flush( &f );
+	ln = bm_flush( &l );
+	qn = bm_flush( &q );
+	
+	mem_le32( blk_buf, fn );
+	mem_le32( blk_buf+4, ln );
+	mem_le32( blk_buf+8, qn );
+	n = 12;
+	memcpy( blk_buf+n, bm_buf[0], fn ); n += fn;
+	memcpy( blk_buf+n, bm_buf[1], ln ); n += ln;
+	memcpy( blk_buf+n, bm_buf[2], qn ); n += qn;
+	memcpy( blk_buf+n, lit_buf, nlit ); n += nlit;
+	return n;
+}
+
+/* writes a length in 255-byte extensions after its 4-bit token field. */
+static inline unsigned char *put_ext( unsigned char *b, unsigned int n )
+{
+	while ( n >= 255 ) {
+		*b++ = 255;
+		n -= 255;
+	}
+	*b++ = n;
+	return b;
+}
+
+/*
+Writes the sequences of a block as byte-aligned tokens:
+
+	token:      literal count (high 4 bits), match length-MIN_LEN (low 4 bits);
+	            a field of 15 continues in extension bytes of 255;
+	literals:   the raw literal bytes;
+	distance:   distance-1 in (num_POS_BITS+7)/8 bytes, little-endian;
+	            absent when the literals end the block.
+*/
+unsigned int put_fast( unsigned int nseq )
+{
+	unsigned char *b = blk_buf, *lp = lit_buf;
+	unsigned int i, d, ln, nb = (num_POS_BITS+7) >> 3;
+	seq_t *s;
+	
+	for ( i = 0, s = seq_buf; i < nseq; i++, s++ ) {
+		ln = s->len ? s->len - MIN_LEN : 0;
+		*b++ = ((s->lit < 15 ? s->lit : 15) << 4) | (ln < 15 ? ln : 15);
+		if ( s->lit >= 15 ) b = put_ext( b, s->lit-15 );
+		memcpy( b, lp, s->lit );
+		b += s->lit, lp += s->lit;
+		if ( s->len == 0 ) break;
+		d = s->dist-1;
+		*b++ = d & 0xff;
+		*b++ = (d >> 8) & 0xff;
+		if ( nb > 2 ) *b++ = (d >> 16) & 0xff;
+		if ( nb > 3 ) *b++ = (d >> 24) & 0xff;
+		if ( ln >= 15 ) b = put_ext( b, ln-15 );
+	}
+	return (unsigned int) (b - blk_buf);
+}
+
+/* quick test of the next n bytes of the pattern buffer: are they random? */
+static inline int incompressible( unsigned char *w, unsigned char *p, unsigned int n )
+{
+	unsigned int i, o, c[256];
+	int pc = pat_cnt, wc = win_cnt;
+	uint64_t sum = 0;
+	
+	memset( c, 0, sizeof(c) );
+	for ( i = 0; i < n; i++ ) c[ p[(pat_cnt+i) & pat_MASK] ]++;
+	for ( i = 0; i < 256; i++ ) sum += (uint64_t) c[i] * c[i];
+	if ( sum * STORE_ENTROPY >= (uint64_t) n * n ) return 0;
+	
+	/* random bytes may still repeat (say, a copy of a compressed file)
+		so probe the hash lists at a few points of the block; the
+		STORE_STRIDE positions of a point meet a hashed stored position. */
+	for ( i = 0; i < STORE_PROBES*STORE_STRIDE; i++ ) {
+		o = (i / STORE_STRIDE) * (n / STORE_PROBES) + (i % STORE_STRIDE);
+		if ( o >= n ) break;
+		pat_cnt = (pc+o) & pat_MASK;
+		win_cnt = (wc+o) & win_MASK;
+		blk_left = n-o;
+		search( w, p );
+		if ( dpos.len >= MIN_LEN ) break;
+	}
+	pat_cnt = pc;
+	win_cnt = wc;
+	return dpos.len < MIN_LEN;
+}
+
+static inline void put_block( int type, unsigned int raw_n, unsigned int n )
+{
+	pfputc( type );
+	put_le32( raw_n );
+	put_le32( n );
+	pfwrite( blk_buf, n );
+}
+
+/* adds the last n bytes of the window to the checksums (FMT_CHECKSUM). */
+static inline void sum_window( unsigned char *w, unsigned int n )
+{
+	unsigned int k = (win_cnt-n) & win_MASK, m;
+	
+	while ( n > 0 ) {
+		m = win_BUFSIZE-k < n ? win_BUFSIZE-k : n;
+		xxh32_update( &blk_SUM, w+k, m );
+		xxh32_update( &frame_SUM, w+k, m );
+		k = (k+m) & win_MASK;
+		n -= m;
+	}
+}
+
+/* ends a block of n raw bytes, now in the window, with its checksum. */
+static inline void put_sum( unsigned char *w, unsigned int n )
+{
+	if ( !sum_MODE ) return;
+	sum_window( w, n );
+	put_le32( xxh32_digest( &blk_SUM ) );
+	xxh32_init( &blk_SUM, 0 );
+}
+
+/* ---- seekable frames ---- */
+
+/* records a restart point: content offset o, at frame offset f. */
+static inline void add_restart( int64_t o, int64_t f )
+{
+	int64_t *t;
+	
+	if ( seek_N == seek_MAX ) {
+		t = (int64_t *) big_alloc( sizeof(int64_t) * 2 * (seek_MAX ? 2*seek_MAX : 1024) );
+		if ( !t ) {
+			fprintf(stderr, "\nError alloc: seek table.");
+			exit (0);
+		}
+		if ( seek_TAB ) memcpy( t, seek_TAB, sizeof(int64_t) * 2 * seek_N );
+		big_free( seek_TAB, sizeof(int64_t) * 2 * seek_MAX );
+		seek_TAB = t;
+		seek_MAX = seek_MAX ? 2*seek_MAX : 1024;
+	}
+	seek_TAB[2*seek_N] = o;
+	seek_TAB[2*seek_N+1] = f;
+	seek_N++;
+}
+
+static inline void put_le64( int64_t k )
+{
+	put_le32( (unsigned int) k );
+	put_le32( (unsigned int) ((uint64_t) k >> 32) );
+}
+
+/* the seek table, at the end of the frame (see lzufmt.h). */
+void put_seek_table( void )
+{
+	unsigned int i;
+	
+	for ( i = 0; i < 2*seek_N; i++ ) put_le64( seek_TAB[i] );
+	put_le64( in_POS );
+	put_le32( seek_N );
+	pfwrite( (const unsigned char *) LZUF_SEEK_MAGIC, 4 );
+}
+
+static inline int64_t mem_get_le64( const unsigned char *b )
+{
+	return (int64_t) (mem_get_le32( b ) | ((uint64_t) mem_get_le32( b+4 ) << 32));
+}
+
+/* ---- long-distance matching ---- */
+
+void ldm_init( void )
+{
+	uint64_t x = 0, z;
+	int i;
+	
+	/* the gear table: fixed pseudo-random words (splitmix64). */
+	for ( i = 0; i < 256; i++ ) {
+		z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		ldm_GEAR[i] = z ^ (z >> 31);
+	}
+	ldm_TABLE = (ldm_t *) big_alloc( sizeof(ldm_t) << LDM_BITS );
+	ldm_buf[0] = (unsigned char *) big_alloc( LDM_CHUNK );
+	ldm_buf[1] = (unsigned char *) big_alloc( LDM_CHUNK );
+	if ( !ldm_TABLE || !ldm_buf[0] || !ldm_buf[1] ) {
+		fprintf(stderr, "\nError alloc: long-match table.");
+		exit (0);
+	}
+}
+
+/* reads n bytes at offset a of the input file; returns the bytes read. */
+static inline unsigned int ldm_read( unsigned char *b, int64_t a, unsigned int n )
+{
+	if ( fseeko( ldm_FILE, a, SEEK_SET ) != 0 ) return 0;
+	return (unsigned int) fread( b, 1, n, ldm_FILE );
+}
+
+/* the length of the match of the input at c with the input at o, o < c. */
+static inline unsigned int ldm_forward( int64_t o, int64_t c, unsigned int max )
+{
+	unsigned int len = 0, n, i;
+	
+	while ( len < max ) {
+		n = max-len < LDM_CHUNK ? max-len : LDM_CHUNK;
+		n = ldm_read( ldm_buf[1], c+len, n );
+		if ( ldm_read( ldm_buf[0], o+len, n ) != n ) break;
+		for ( i = 0; i < n && ldm_buf[0][i] == ldm_buf[1][i]; i++ ) ;
+		len += i;
+		if ( i < LDM_CHUNK ) break;
+	}
+	return len;
+}
+
+/* the same, backward: the length of the match of the bytes before c and o. */
+static inline unsigned int ldm_backward( int64_t o, int64_t c, unsigned int max )
+{
+	unsigned int len = 0, n, i;
+	
+	while ( len < max ) {
+		n = max-len < LDM_CHUNK ? max-len : LDM_CHUNK;
+		if ( ldm_read( ldm_buf[0], o-len-n, n ) != n
+			|| ldm_read( ldm_buf[1], c-len-n, n ) != n ) break;
+		for ( i = 0; i < n && ldm_buf[0][n-1-i] == ldm_buf[1][n-1-i]; i++ ) ;
+		len += i;
+		if ( i < n ) break;
+	}
+	return len;
+}
+
+/*
+Hashes the next n bytes of the pattern buffer into the long-match
+table, up to the first match with a far position of the same hash.
+The match is verified on the input file and extended both ways, up
+to the start of the block; its start, length and distance are left
+in ldm_AT, ldm_LEN and ldm_DIST. Matches nearer than a block are
+left to search().
+*/
+static inline void ldm_scan( unsigned char *p, unsigned int n )
+{
+	int64_t s, c, o, end = in_POS+n;
+	uint64_t h = ldm_HASH;
+	unsigned int len, k;
+	ldm_t *e;
+	
+	for ( s = ldm_NEXT; s < end; s++ ) {
+		h = (h << 1) + ldm_GEAR[ p[(pat_cnt + (unsigned int) (s-in_POS)) & pat_MASK] ];
+		if ( ++ldm_FED < LDM_WIN || (h >> (64-LDM_RATE)) != 0 ) continue;
+		e = &ldm_TABLE[ (h >> (64-LDM_RATE-LDM_BITS)) & ((1<<LDM_BITS)-1) ];
+		if ( e->hash == h && e->pos > ldm_BASE && s-(e->pos-ldm_BASE) > blk_SIZE ) {
+			/* the hashed bytes end at s and at e->pos. */
+			c = s-(LDM_WIN-1);
+			o = e->pos-ldm_BASE-(LDM_WIN-1);
+			if ( c < in_POS ) {
+				o += in_POS-c;
+				c = in_POS;
+			}
+			len = ldm_forward( o, c, LDM_MAX_LEN-blk_SIZE );
+			k = (unsigned int) (c-in_POS);
+			if ( k > o ) k = (unsigned int) o;
+			if ( len > 0 ) len += (k = ldm_backward( o, c, k ));
+			if ( len >= LDM_MIN_LEN ) {
+				ldm_AT = c-k;
+				ldm_LEN = len;
+				ldm_DIST = c-o;
+				e->pos = ldm_BASE+s;
+				ldm_NEXT = s+1;
+				ldm_HASH = h;
+				return;
+			}
+		}
+		e->hash = h;
+		e->pos = ldm_BASE+s;
+	}
+	ldm_NEXT = end;
+	ldm_HASH = h;
+}
+
+/* writes the long match as a block, and slides the buffers over it. */
+static inline void put_long( unsigned char *w, unsigned char *p )
+{
+	unsigned int n;
+	
+	mem_le32( blk_buf, (unsigned int) ldm_DIST );
+	mem_le32( blk_buf+4, (unsigned int) (ldm_DIST >> 32) );
+	put_block( BLK_LONG, ldm_LEN, 8 );
+	while ( ldm_LEN > 0 && buf_cnt > 0 ) {
+		n = ldm_LEN < blk_SIZE ? ldm_LEN : blk_SIZE;
+		if ( n > (unsigned int) buf_cnt ) n = buf_cnt;
+		slide_raw( w, p, n, STORE_STRIDE );
+		if ( sum_MODE ) sum_window( w, n );
+		in_POS += n;
+		ldm_LEN -= n;
+	}
+	put_sum( w, 0 );
+	/* the hash starts over after the match. */
+	ldm_NEXT = in_POS;
+	ldm_FED = 0;
+	ldm_LEN = 0;
+}
+
+void compress_blocks( unsigned char *w, unsigned char *p )
+{
+	unsigned int nseq, nlit, run, n, i, back, blk_n, min_len = MIN_LEN, misses = 0;
+	int64_t seek_next = 0;
+	
+	/* a byte-aligned match costs a token and the distance bytes. */
+	if ( fmt_PROF == FMT_BYTE ) min_len = MIN_LEN + 2*(((num_POS_BITS+7) >> 3) - 2);
+	blk_MODE = 1;
+	xxh32_init( &blk_SUM, 0 );
+	xxh32_init( &frame_SUM, 0 );
+	while ( buf_cnt > 0 ) {
+		n = buf_cnt < blk_SIZE ? buf_cnt : blk_SIZE;
+		
+		/* a restart point: no match reaches back before it. */
+		if ( seek_MODE && in_POS >= seek_next ) {
+			add_restart( in_POS, nbytes_out + pbuf_count );
+			hist_CNT = 0;
+			seek_next = in_POS + ((int64_t) 1 << seek_BITS);
+		}
+		
+		/* a long match ends the block before it. */
+		if ( ldm_MODE ) {
+			if ( ldm_LEN == 0 ) ldm_scan( p, n );
+			if ( ldm_LEN ) {
+				if ( ldm_AT == in_POS ) {
+					put_long( w, p );
+					continue;
+				}
+				n = (unsigned int) (ldm_AT-in_POS);
+			}
+		}
+		
+		/* store an incompressible block, with no search at all. */
+		if ( incompressible( w, p, n ) ) {
+			for ( i = 0; i < n; i++ ) blk_buf[i] = p[(pat_cnt+i) & pat_MASK];
+			slide_raw( w, p, n, STORE_STRIDE );
+			put_block( BLK_STORED, n, n );
+			put_sum( w, n );
+			in_POS += n;
+			continue;
+		}
+		
+		blk_left = blk_n = n;
+		nseq = nlit = run = 0;
+		init_reps( rep_DIST );  /* as put_split() does. */
+		while ( buf_cnt > 0 && blk_left > 0 ) {
+			/* a byte run, coded with no search. */
+			if ( (n = run_length( w, p )) >= RUN_MIN ) {
+				back = extend_back( w, run, 1, n );
+				nlit -= back;
+				seq_buf[nseq].lit = run-back;
+				seq_buf[nseq].len = n+back;
+				seq_buf[nseq].dist = 1;
+				if ( rep_MODE ) update_reps( rep_DIST, 1 );
+				nseq++;
+				run = 0;
+				blk_left -= n;
+				slide_run( w, p, n );
+				misses = 0;
+				continue;
+			}
+			search( w, p );
+			if ( dpos.len >= min_len ) {
+				/* the match takes over the literals that it extends to. */
+				n = ((win_cnt-dpos.pos-1) & win_MASK) + 1;
+				back = extend_back( w, run, n, dpos.len );
+				nlit -= back;
+				seq_buf[nseq].lit = run-back;
+				seq_buf[nseq].len = dpos.len+back;
+				seq_buf[nseq].dist = n;
+				if ( rep_MODE ) update_reps( rep_DIST, seq_buf[nseq].dist );
+				nseq++;
+				run = 0;
+			}
+			else {
+				dpos.len = 1;
+				lit_buf[nlit++] = p[pat_cnt];
+				run++;
+			}
+			blk_left -= dpos.len;
+			slide( w, p );
+			
+			/* acceleration, as in compress(). */
+			if ( dpos.len > 1 ) misses = 0;
+			else if ( (n = (++misses * a_ACCEL) >> SKIP_TRIGGER) > 0 ) {
+				if ( n > buf_cnt ) n = buf_cnt;
+				if ( n > blk_left ) n = blk_left;
+				for ( i = 0; i < n; i++ ) lit_buf[nlit++] = p[(pat_cnt+i) & pat_MASK];
+				run += n;
+				blk_left -= n;
+				slide_raw( w, p, n, 0 );
+			}
+		}
+		if ( run ) {
+			seq_buf[nseq].lit = run;
+			seq_buf[nseq].len = 0;
+			nseq++;
+		}
+		if ( fmt_PROF == FMT_BYTE ) n = put_fast( nseq );
+		else n = put_split( nseq, nlit );
+		if ( n < blk_n-blk_left ) put_block( BLK_CODED, blk_n-blk_left, n );
+		else {
+			/* no gain; store the block, it's in the window. */
+			n = blk_n-blk_left;
+			for ( i = 0; i < n; i++ ) blk_buf[i] = w[(win_cnt-n+i) & win_MASK];
+			put_block( BLK_STORED, n, n );
+		}
+		put_sum( w, blk_n-blk_left );
+		in_POS += blk_n-blk_left;
+	}
+	if ( eos_MODE ) pfputc( BLK_END );
+	if ( sum_MODE ) put_le32( xxh32_digest( &frame_SUM ) );
+	if ( seek_MODE ) put_seek_table();
+}
+
+/* forward copy of a match; the source may overlap the destination. */
+static inline void copy_match( unsigned char *d, unsigned int dist, unsigned int len )
+{
+	unsigned char *s = d - dist;
+	
+	if ( dist >= 8 ) {
+		/* 8 bytes at a time, may write up to 7 bytes past the match. */
+		do {
+			memcpy( d, s, 8 );
+			d += 8, s += 8;
+		} while ( len > 8 && (len -= 8) );
+	}
+	else if ( dist == 1 ) memset( d, *s, len );  /* a byte run. */
+	else while ( len-- ) *d++ = *s++;
+}
+
+/*
+Decodes a split-stream block into out[0..raw_n-1]; out[-hist..-1]
+is the history. Returns 0 on a corrupt block. The window bits (wb),
+literal runs and repeat distances are constants of each instance.
+*/
+KERNEL int get_split_k( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist, const int wb, const int runs, const int reps )
+{
+	bitmem_t f, l, q;
+	unsigned char *op = out, *oend = out+raw_n, *lp, *lend;
+	unsigned int fn, ln, qn, len, dist, r[REP_N];
+	
+	if ( n < 12 ) return 0;
+	fn = mem_get_le32( src );
+	ln = mem_get_le32( src+4 );
+	qn = mem_get_le32( src+8 );
+	if ( fn > n-12 || ln > n-12-fn || qn > n-12-fn-ln ) return 0;
+	bm_init_get( &f, src+12, fn );
+	bm_init_get( &l, src+12+fn, ln );
+	bm_init_get( &q, src+12+fn+ln, qn );
+	lp = src+12+fn+ln+qn;
+	lend = src+n;
+	init_reps( r );
+	
+	while ( op < oend ) {
+		if ( bm_get_bit( &f ) ) {
+			len = bm_get_golomb( &l, MFOLD ) + (MIN_LEN+1);
+		}
+		else if ( bm_get_bit( &f ) ) len = MIN_LEN;
+		else if ( runs ) {
+			/* a run of literals, in one copy; a bad code (VLC_BAD) never fits. */
+			len = bm_get_vlcode( &l, LIT_RUN_BITS );
+			if ( len >= (unsigned int) (lend-lp) || len >= (unsigned int) (oend-op) ) return 0;
+			len++;
+			memcpy( op, lp, len );
+			op += len, lp += len;
+			continue;
+		}
+		else {
+			if ( lp == lend ) return 0;
+			*op++ = *lp++;
+			continue;
+		}
+		if ( reps && bm_get_bit( &q ) ) dist = r[ bm_get_nbits( &q, REP_BITS ) ];
+		else dist = bm_get_nbits( &q, wb ) + 1;
+		if ( reps ) update_reps( r, dist );
+		if ( dist > (unsigned int) (op-out)+hist || len > (unsigned int) (oend-op) )
+			return 0;
+		copy_match( op, dist, len );
+		op += len;
+	}
+	return 1;
+}
+
+/*
+Decodes a byte-aligned block with nb distance bytes; same interface
+as get_split_k(). A short literal run is copied 16 bytes at a time
+when the source block and the output buffer both have the room. A
+tight decoder writes nothing past out[raw_n-1], for an output buffer
+with no slack (a small payload).
+*/
+KERNEL int get_fast_k( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist, const unsigned int nb, const int tight )
+{
+	unsigned char *ip = src, *iend = src+n, *op = out, *oend = out+raw_n;
+	unsigned int token, lit, len, dist, c;
+	
+	while ( op < oend ) {
+		if ( ip >= iend ) return 0;
+		token = *ip++;
+		
+		/* literals. */
+		if ( (lit = token >> 4) == 15 ) do {
+			if ( ip >= iend ) return 0;
+			lit += (c = *ip++);
+		} while ( c == 255 );
+		if ( lit > (unsigned int) (iend-ip) || lit > (unsigned int) (oend-op) ) return 0;
+		if ( lit <= 16 && iend-ip >= 16 && (!tight || oend-op >= 16) ) memcpy( op, ip, 16 );
+		else memcpy( op, ip, lit );
+		op += lit, ip += lit;
+		if ( op == oend ) break;
+		
+		/* match. */
+		if ( (unsigned int) (iend-ip) < nb ) return 0;
+		dist = ip[0] | (ip[1] << 8);
+		if ( nb > 2 ) dist |= ip[2] << 16;
+		if ( nb > 3 ) dist |= (unsigned int) ip[3] << 24;
+		ip += nb;
+		dist++;
+		if ( (len = token & 15) == 15 ) do {
+			if ( ip >= iend ) return 0;
+			len += (c = *ip++);
+		} while ( c == 255 );
+		len += MIN_LEN;
+		if ( dist > (unsigned int) (op-out)+hist || len > (unsigned int) (oend-op) )
+			return 0;
+		if ( tight && len+8 > (unsigned int) (oend-op) ) {
+			/* at the end of the output, one byte at a time. */
+			for ( ; len > 0; len--, op++ ) *op = *(op-dist);
+			continue;
+		}
+		copy_match( op, dist, len );
+		op += len;
+	}
+	return 1;
+}
+
+/* ---- the decoder instances ---- */
+
+typedef void (*decode_fn)( unsigned char *w, unsigned char *p );
+typedef int (*block_fn)( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist );
+
+/*
+One instance of each decoder per window size (wb) and literal coding
+(m = literal runs | repeat distances << 1), so that the masks, shifts
+and tests of these parameters fold; the decoder is picked once, from
+the file stamp.
+*/
+#define DECODERS(wb,m) \
+INSTANCE void decompress_##wb##_##m( unsigned char *w, unsigned char *p ) \
+{ \
+	decompress_k( w, p, wb, (m) & 1, (m) >> 1, 0 ); \
+} \
+INSTANCE int get_split_##wb##_##m( unsigned char *src, unsigned int n, unsigned char *out, \
+	unsigned int raw_n, unsigned int hist ) \
+{ \
+	return get_split_k( src, n, out, raw_n, hist, wb, (m) & 1, (m) >> 1 ); \
+}
+#define DECODERS_WB(wb) DECODERS(wb,0) DECODERS(wb,1) DECODERS(wb,2) DECODERS(wb,3)
+
+DECODERS_WB(12) DECODERS_WB(13) DECODERS_WB(14) DECODERS_WB(15) DECODERS_WB(16)
+DECODERS_WB(17) DECODERS_WB(18) DECODERS_WB(19) DECODERS_WB(20) DECODERS_WB(21)
+DECODERS_WB(22) DECODERS_WB(23) DECODERS_WB(24) DECODERS_WB(25) DECODERS_WB(26)
+
+/* the MTF dialect (lzuf622) has neither literal runs nor repeat distances. */
+#define DECODER_MTF(wb) \
+INSTANCE void decompress_mtf_##wb( unsigned char *w, unsigned char *p ) \
+{ \
+	decompress_k( w, p, wb, 0, 0, 1 ); \
+}
+
+DECODER_MTF(12) DECODER_MTF(13) DECODER_MTF(14) DECODER_MTF(15) DECODER_MTF(16)
+DECODER_MTF(17) DECODER_MTF(18) DECODER_MTF(19) DECODER_MTF(20) DECODER_MTF(21)
+DECODER_MTF(22) DECODER_MTF(23) DECODER_MTF(24) DECODER_MTF(25) DECODER_MTF(26)
+
+#define DECOMPRESS_ROW(wb) [wb] = { decompress_##wb##_0, decompress_##wb##_1, \
+	decompress_##wb##_2, decompress_##wb##_3 }
+#define GET_SPLIT_ROW(wb) [wb] = { get_split_##wb##_0, get_split_##wb##_1, \
+	get_split_##wb##_2, get_split_##wb##_3 }
+
+static const decode_fn decompress_fn[MAX_POS_BITS+1][4] = {
+	DECOMPRESS_ROW(12), DECOMPRESS_ROW(13), DECOMPRESS_ROW(14), DECOMPRESS_ROW(15),
+	DECOMPRESS_ROW(16), DECOMPRESS_ROW(17), DECOMPRESS_ROW(18), DECOMPRESS_ROW(19),
+	DECOMPRESS_ROW(20), DECOMPRESS_ROW(21), DECOMPRESS_ROW(22), DECOMPRESS_ROW(23),
+	DECOMPRESS_ROW(24), DECOMPRESS_ROW(25), DECOMPRESS_ROW(26)
+};
+
+static const decode_fn decompress_mtf_fn[MAX_POS_BITS+1] = {
+	[12] = decompress_mtf_12, [13] = decompress_mtf_13, [14] = decompress_mtf_14,
+	[15] = decompress_mtf_15, [16] = decompress_mtf_16, [17] = decompress_mtf_17,
+	[18] = decompress_mtf_18, [19] = decompress_mtf_19, [20] = decompress_mtf_20,
+	[21] = decompress_mtf_21, [22] = decompress_mtf_22, [23] = decompress_mtf_23,
+	[24] = decompress_mtf_24, [25] = decompress_mtf_25, [26] = decompress_mtf_26
+};
+
+static const block_fn get_split_fn[MAX_POS_BITS+1][4] = {
+	GET_SPLIT_ROW(12), GET_SPLIT_ROW(13), GET_SPLIT_ROW(14), GET_SPLIT_ROW(15),
+	GET_SPLIT_ROW(16), GET_SPLIT_ROW(17), GET_SPLIT_ROW(18), GET_SPLIT_ROW(19),
+	GET_SPLIT_ROW(20), GET_SPLIT_ROW(21), GET_SPLIT_ROW(22), GET_SPLIT_ROW(23),
+	GET_SPLIT_ROW(24), GET_SPLIT_ROW(25), GET_SPLIT_ROW(26)
+};
+
+/* the byte-aligned decoder only depends on the bytes of a distance. */
+INSTANCE int get_fast_2( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist )
+{
+	return get_fast_k( src, n, out, raw_n, hist, 2, 0 );
+}
+
+INSTANCE int get_fast_3( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist )
+{
+	return get_fast_k( src, n, out, raw_n, hist, 3, 0 );
+}
+
+INSTANCE int get_fast_4( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist )
+{
+	return get_fast_k( src, n, out, raw_n, hist, 4, 0 );
+}
+
+static const block_fn get_fast_fn[5] = { NULL, NULL, get_fast_2, get_fast_3, get_fast_4 };
+
+/* small payloads are decoded straight into the caller's buffer. */
+INSTANCE int get_fast_tight( unsigned char *src, unsigned int n, unsigned char *out,
+	unsigned int raw_n, unsigned int hist )
+{
+	return get_fast_k( src, n, out, raw_n, hist, 2, 1 );
+}
+
+void decompress( unsigned char *w, unsigned char *p )
+{
+	if ( mtf_MODE ) decompress_mtf_fn[ num_POS_BITS ]( w, p );
+	else decompress_fn[ num_POS_BITS ][ lit_RUNS | rep_MODE << 1 ]( w, p );
+}
+
+/* writes the part of the n bytes at content offset o that is in the range. */
+static inline void put_range( unsigned char *b, unsigned int n, int64_t o )
+{
+	if ( o+n <= rng_START || o >= rng_END ) return;
+	if ( o < rng_START ) {
+		b += rng_START-o;
+		n -= (unsigned int) (rng_START-o);
+		o = rng_START;
+	}
+	if ( o+n > rng_END ) n = (unsigned int) (rng_END-o);
+	pfwrite( b, n );
+}
+
+/*
+The decoder keeps the output in a flat buffer of 2*win_BUFSIZE+blk_SIZE
+bytes; when the next block does not fit, the last win_BUFSIZE bytes
+are moved to the front. A long-match block is copied from the output
+file itself, a block at a time; its distance is more than a block.
+Returns 0 on a corrupt block or a checksum mismatch.
+*/
+int decompress_blocks( void )
+{
+	unsigned char *dbuf, *src;
+	unsigned int dsize, dcnt = 0, keep, type, raw_n, n;
+	block_fn get_block = fmt_PROF == FMT_BYTE ? get_fast_fn[ (num_POS_BITS+7) >> 3 ]
+		: get_split_fn[ num_POS_BITS ][ lit_RUNS | rep_MODE << 1 ];
+	int64_t fsize = fstamp.file_size, out_pos = 0, blk_pos, dist;
+	
+	blk_SIZE = 1<<BLOCK_BITS;
+	if ( blk_SIZE > win_BUFSIZE ) blk_SIZE = win_BUFSIZE;
+	dsize = 2*win_BUFSIZE+blk_SIZE;
+	dbuf = (unsigned char *) big_alloc( dsize+32 );
+	src = (unsigned char *) big_alloc( 2*blk_SIZE+64 );
+	if ( !dbuf || !src ) {
+		fprintf(stderr, "\nError alloc: block buffers.");
+		exit (0);
+	}
+	xxh32_init( &blk_SUM, 0 );
+	xxh32_init( &frame_SUM, 0 );
+	
+	/* a range ends with the block that has its last byte. */
+	if ( rng_MODE && fsize > rng_END ) fsize = rng_END;
+	while ( fsize > 0 ) {
+		blk_pos = out_pos;
+		type = gfgetc();
+		if ( eos_MODE && type == BLK_END ) break;
+		raw_n = get_le32();
+		n = get_le32();
+		if ( type == BLK_LONG ) {
+			if ( !ldm_MODE || raw_n == 0 || raw_n > fsize || n != 8 || gfread( src, n ) != n )
+				goto corrupt;
+			dist = mem_get_le32( src ) | ((int64_t) mem_get_le32( src+4 ) << 32);
+			if ( dist <= blk_SIZE || dist > out_pos ) goto corrupt;
+			
+			/* copy from the output file, a block at a time. */
+			for ( ; raw_n > 0; raw_n -= n ) {
+				n = raw_n < blk_SIZE ? raw_n : blk_SIZE;
+				if ( dcnt+n > dsize ) {
+					keep = dcnt < win_BUFSIZE ? dcnt : win_BUFSIZE;
+					memmove( dbuf, dbuf+dcnt-keep, keep );
+					dcnt = keep;
+				}
+				flush_put_buffer();
+				if ( fseeko( pOUT, out_pos-dist, SEEK_SET ) != 0
+					|| fread( dbuf+dcnt, 1, n, pOUT ) != n ) goto corrupt;
+				fseeko( pOUT, 0, SEEK_END );
+				pfwrite( dbuf+dcnt, n );
+				if ( sum_MODE ) {
+					xxh32_update( &blk_SUM, dbuf+dcnt, n );
+					xxh32_update( &frame_SUM, dbuf+dcnt, n );
+				}
+				dcnt += n;
+				out_pos += n;
+				fsize -= n;
+			}
+			if ( sum_MODE && get_le32() != xxh32_digest( &blk_SUM ) ) goto bad_sum;
+			xxh32_init( &blk_SUM, 0 );
+			continue;
+		}
+		if ( (type != BLK_CODED && type != BLK_STORED) || raw_n == 0 || raw_n > blk_SIZE
+			|| n > 2*blk_SIZE+64 || gfread( src, n ) != n ) goto corrupt;
+		if ( dcnt+raw_n > dsize ) {
+			keep = dcnt < win_BUFSIZE ? dcnt : win_BUFSIZE;
+			memmove( dbuf, dbuf+dcnt-keep, keep );
+			dcnt = keep;
+		}
+		if ( type == BLK_STORED ) {
+			if ( n != raw_n ) goto corrupt;
+			memcpy( dbuf+dcnt, src, n );
+		}
+		else if ( !get_block( src, n, dbuf+dcnt, raw_n, dcnt ) ) goto corrupt;
+		if ( rng_MODE ) put_range( dbuf+dcnt, raw_n, out_pos );
+		else pfwrite( dbuf+dcnt, raw_n );
+		if ( sum_MODE ) {
+			/* the checksum of the raw bytes follows the block. */
+			xxh32_update( &blk_SUM, dbuf+dcnt, raw_n );
+			xxh32_update( &frame_SUM, dbuf+dcnt, raw_n );
+			if ( get_le32() != xxh32_digest( &blk_SUM ) ) goto bad_sum;
+			xxh32_init( &blk_SUM, 0 );
+		}
+		dcnt += raw_n;
+		out_pos += raw_n;
+		fsize -= raw_n;
+	}
+	if ( sum_MODE && !rng_MODE && get_le32() != xxh32_digest( &frame_SUM ) ) {
+		fprintf(stderr, "\nError: content checksum mismatch.");
+		goto halt;
+	}
+	big_free( dbuf, dsize+32 );
+	big_free( src, 2*blk_SIZE+64 );
+	return 1;
+	
+	corrupt:
+	fprintf(stderr, "\nError: corrupt block.");
+	goto halt;
+	
+	bad_sum:
+	fprintf(stderr, "\nError: checksum mismatch in the block at %lld.", (long long) blk_pos );
+	
+	halt:
+	big_free( dbuf, dsize+32 );
+	big_free( src, 2*blk_SIZE+64 );
+	return 0;
+}
+
+/* ---- the reader of seekable files (lzuf.h) ---- */
+
+/* the library selects the SIMD kernels of the host (or of -t, in
+	the program) once, when a reader or a context is first made. */
+static rd_once_t lib_ONCE = RD_ONCE_INIT;
+
+#if defined(_WIN32)
+static BOOL CALLBACK lib_init_once( PINIT_ONCE o, PVOID a, PVOID *c )
+{
+	simd_init( simd_TIER );
+	return TRUE;
+}
+
+static inline void lib_init( void )
+{
+	InitOnceExecuteOnce( &lib_ONCE, lib_init_once, NULL, NULL );
+}
+#else
+static void lib_init_once( void )
+{
+	simd_init( simd_TIER );
+}
+
+static inline void lib_init( void )
+{
+	pthread_once( &lib_ONCE, lib_init_once );
+}
+#endif
+
+/* a decoded segment: the content from restart point i to the next. */
+typedef struct rd_seg {
+	unsigned int i, n;
+	unsigned char *data;
+	int refs;                 /* the readers copying from it. */
+	struct rd_seg *prev, *next;  /* the list of the idle segments. */
+} rd_seg;
+
+struct lzuf_reader {
+#if defined(_WIN32)
+	FILE *f;
+	rd_lock_t io;             /* the position of f. */
+#else
+	int fd;
+#endif
+	int64_t size;             /* the content size. */
+	int64_t *tab;             /* content and frame offsets of the restart
+	                             points, in pairs; then the content size
+	                             and the offset of the seek table. */
+	unsigned int ntab;
+	unsigned int blk_size;
+	int sums;                 /* FMT_CHECKSUM */
+	block_fn get_block;
+	
+	/* the cache, indexed by restart point; the segments not in use
+	   are in a list, the most recently used first, and the last one
+	   is dropped first. A segment in use is not dropped. */
+	rd_lock_t lock;
+	rd_seg **seg;             /* ntab entries; NULL if not cached. */
+	rd_seg *lru_first, *lru_last;
+	size_t cached, cache_size;
+};
+
+/* the biggest segment, and the biggest seek table, a reader takes. */
+#define RD_SEG_MAX   (1u<<SEEK_MAX_BITS)
+#define RD_TAB_MAX   (1u<<26)
+
+/* frees a segment, and its content. */
+static inline void rd_free( rd_seg *s )
+{
+	big_free( s->data, s->n+32 );
+	big_free( s, sizeof(rd_seg) );
+}
+
+/* reads n bytes at offset o of the file; 0 if they are not all there. */
+static int rd_read( lzuf_reader *r, void *b, size_t n, int64_t o )
+{
+#if defined(_WIN32)
+	size_t k = 0;
+	
+	rd_lock( &r->io );
+	if ( _fseeki64( r->f, o, SEEK_SET ) == 0 ) k = fread( b, 1, n, r->f );
+	rd_unlock( &r->io );
+	return k == n;
+#else
+	ssize_t k;
+	
+	while ( n > 0 ) {
+		if ( (k = pread( r->fd, b, n, o )) <= 0 ) {
+			if ( k < 0 && errno == EINTR ) continue;
+			return 0;
+		}
+		b = (unsigned char *) b + k;
+		n -= k;
+		o += k;
+	}
+	return 1;
+#endif
+}
+
+static int64_t rd_file_size( lzuf_reader *r )
+{
+#if defined(_WIN32)
+	if ( _fseeki64( r->f, 0, SEEK_END ) != 0 ) return -1;
+	return _ftelli64( r->f );
+#else
+	return lseek( r->fd, 0, SEEK_END );
+#endif
+}
+
+/* reads the stamp and the seek table; 0 if they are not right. */
+static int rd_init( lzuf_reader *r )
+{
+	unsigned char b[LZUF_STAMP_SIZE], *t;
+	file_stamp s;
+	int64_t end, tab;
+	unsigned int i, n, wb;
+	
+	if ( !rd_read( r, b, LZUF_STAMP_SIZE, 0 ) ) return 0;
+	get_stamp( b, &s );
+	wb = s.num_pos_bits;
+	if ( stamp_dialect( &s ) != LZUF_RAW || !(s.format & FMT_SEEK) || (s.format & FMT_LONG)
+		|| ((s.format & FMT_MASK) != FMT_SPLIT && (s.format & FMT_MASK) != FMT_BYTE)
+		|| wb < 12 || wb > MAX_POS_BITS ) return 0;
+	r->blk_size = 1<<BLOCK_BITS;
+	if ( r->blk_size > 1u<<wb ) r->blk_size = 1u<<wb;
+	r->sums = (s.format & FMT_CHECKSUM) != 0;
+	r->get_block = (s.format & FMT_MASK) == FMT_BYTE ? get_fast_fn[ (wb+7) >> 3 ]
+		: get_split_fn[ wb ][ ((s.format & FMT_LITRUNS) != 0) | ((s.format & FMT_REPS) != 0) << 1 ];
+	
+	/* the footer, and the table before it. */
+	if ( (end = rd_file_size( r ) - LZUF_SEEK_FOOTER) < LZUF_STAMP_SIZE
+		|| !rd_read( r, b, LZUF_SEEK_FOOTER, end ) || memcmp( b+12, LZUF_SEEK_MAGIC, 4 ) != 0 )
+		return 0;
+	r->size = mem_get_le64( b );
+	r->ntab = n = mem_get_le32( b+8 );
+	if ( r->size < 0 || n > RD_TAB_MAX || (!(s.format & FMT_EOS) && s.file_size != r->size) )
+		return 0;
+	tab = end - (int64_t) n * LZUF_SEEK_ENTRY;
+	if ( tab < LZUF_STAMP_SIZE ) return 0;
+	r->tab = (int64_t *) big_alloc( sizeof(int64_t) * 2 * (n+1) );
+	t = (unsigned char *) big_alloc( (size_t) n * LZUF_SEEK_ENTRY + 1 );
+	if ( !r->tab || !t || !rd_read( r, t, (size_t) n * LZUF_SEEK_ENTRY, tab ) ) {
+		big_free( t, (size_t) n * LZUF_SEEK_ENTRY + 1 );
+		return 0;
+	}
+	for ( i = 0; i < 2*n; i++ ) r->tab[i] = mem_get_le64( t + 8*i );
+	big_free( t, (size_t) n * LZUF_SEEK_ENTRY + 1 );
+	r->tab[2*n] = r->size;
+	r->tab[2*n+1] = tab;
+	
+	/* the restart points start at 0, and go up in both offsets. */
+	if ( n > 0 && (r->tab[0] != 0 || r->tab[1] != LZUF_STAMP_SIZE) ) return 0;
+	if ( n == 0 && r->size != 0 ) return 0;
+	for ( i = 0; i < n; i++ ) {
+		if ( r->tab[2*i+2] <= r->tab[2*i] || r->tab[2*i+3] <= r->tab[2*i+1]
+			|| r->tab[2*i+2] - r->tab[2*i] > RD_SEG_MAX ) return 0;
+	}
+	r->seg = (rd_seg **) big_alloc( sizeof(rd_seg *) * (n+1) );
+	return r->seg != NULL;
+}
+
+lzuf_reader *lzuf_open( const char *name, size_t cache_size )
+{
+	lzuf_reader *r;
+	
+	lib_init();
+	if ( (r = (lzuf_reader *) big_alloc( sizeof(lzuf_reader) )) == NULL ) return NULL;
+#if defined(_WIN32)
+	if ( (r->f = fopen( name, "rb" )) == NULL ) {
+		big_free( r, sizeof(lzuf_reader) );
+		return NULL;
+	}
+	rd_lock_init( &r->io );
+#else
+	if ( (r->fd = open( name, O_RDONLY )) < 0 ) {
+		big_free( r, sizeof(lzuf_reader) );
+		return NULL;
+	}
+#endif
+	rd_lock_init( &r->lock );
+	r->cache_size = cache_size ? cache_size : LZUF_CACHE;
+	if ( !rd_init( r ) ) {
+		lzuf_close( r );
+		return NULL;
+	}
+	return r;
+}
+
+int64_t lzuf_size( const lzuf_reader *r )
+{
+	return r->size;
+}
+
+void lzuf_close( lzuf_reader *r )
+{
+	unsigned int i;
+	
+	if ( !r ) return;
+	if ( r->seg ) {
+		for ( i = 0; i < r->ntab; i++ ) {
+			if ( r->seg[i] ) rd_free( r->seg[i] );
+		}
+		big_free( r->seg, sizeof(rd_seg *) * (r->ntab+1) );
+	}
+	big_free( r->tab, sizeof(int64_t) * 2 * (r->ntab+1) );
+	rd_lock_free( &r->lock );
+#if defined(_WIN32)
+	rd_lock_free( &r->io );
+	fclose( r->f );
+#else
+	close( r->fd );
+#endif
+	big_free( r, sizeof(lzuf_reader) );
+}
+
+/*
+Decodes segment i, from the blocks between its restart point and
+the next; returns NULL on a corrupt block. The segment needs nothing
+before it, so the decoders get no history; the output has the slack
+of their wide copies.
+*/
+static unsigned char *rd_decode( lzuf_reader *r, unsigned int i )
+{
+	unsigned int size = (unsigned int) (r->tab[2*i+2] - r->tab[2*i]), dcnt = 0, type, raw_n, n;
+	size_t csize = (size_t) (r->tab[2*i+3] - r->tab[2*i+1]), k = 0;
+	unsigned char *src, *out;
+	
+	src = (unsigned char *) big_alloc( csize );
+	out = (unsigned char *) big_alloc( size+32 );
+	if ( !src || !out || !rd_read( r, src, csize, r->tab[2*i+1] ) ) goto corrupt;
+	while ( dcnt < size ) {
+		if ( csize-k < BLK_HDR_SIZE ) goto corrupt;
+		type = src[k];
+		raw_n = mem_get_le32( src+k+1 );
+		n = mem_get_le32( src+k+5 );
+		k += BLK_HDR_SIZE;
+		if ( (type != BLK_CODED && type != BLK_STORED) || raw_n == 0 || raw_n > r->blk_size
+			|| raw_n > size-dcnt || n > csize-k ) goto corrupt;
+		if ( type == BLK_STORED ) {
+			if ( n != raw_n ) goto corrupt;
+			memcpy( out+dcnt, src+k, n );
+		}
+		else if ( !r->get_block( src+k, n, out+dcnt, raw_n, dcnt ) ) goto corrupt;
+		k += n;
+		if ( r->sums ) {
+			if ( csize-k < 4 || mem_get_le32( src+k ) != xxh32( out+dcnt, raw_n, 0 ) )
+				goto corrupt;
+			k += 4;
+		}
+		dcnt += raw_n;
+	}
+	big_free( src, csize );
+	return out;
+	
+	corrupt:
+	big_free( src, csize );
+	big_free( out, size+32 );
+	return NULL;
+}
+
+/* takes idle segment s out of the list. */
+static inline void rd_unlink( lzuf_reader *r, rd_seg *s )
+{
+	if ( s->prev ) s->prev->next = s->next;
+	else r->lru_first = s->next;
+	if ( s->next ) s->next->prev = s->prev;
+	else r->lru_last = s->prev;
+	s->prev = s->next = NULL;
+}
+
+/* puts segment s, no longer in use, at the front of the list. */
+static inline void rd_push( lzuf_reader *r, rd_seg *s )
+{
+	s->prev = NULL;
+	s->next = r->lru_first;
+	if ( r->lru_first ) r->lru_first->prev = s;
+	else r->lru_last = s;
+	r->lru_first = s;
+}
+
+/* drops the segments used least recently, and not in use, until n more bytes fit. */
+static void rd_evict( lzuf_reader *r, size_t n )
+{
+	rd_seg *s;
+	
+	while ( (s = r->lru_last) != NULL && r->cached + n > r->cache_size ) {
+		rd_unlink( r, s );
+		r->seg[ s->i ] = NULL;
+		r->cached -= s->n;
+		rd_free( s );
+	}
+}
+
+/* segment s is in use by one more reader. */
+static inline void rd_use( lzuf_reader *r, rd_seg *s )
+{
+	if ( s->refs++ == 0 ) rd_unlink( r, s );
+}
+
+/*
+Returns segment i, in use until rd_release(); NULL on a corrupt block.
+A segment is decoded with the cache unlocked, so other readers go on;
+when two readers decode the same segment, the second copy is dropped.
+*/
+static rd_seg *rd_get( lzuf_reader *r, unsigned int i )
+{
+	rd_seg *s;
+	unsigned char *d;
+	unsigned int n = (unsigned int) (r->tab[2*i+2] - r->tab[2*i]);
+	
+	rd_lock( &r->lock );
+	if ( (s = r->seg[i]) != NULL ) rd_use( r, s );
+	rd_unlock( &r->lock );
+	if ( s ) return s;
+	
+	if ( (d = rd_decode( r, i )) == NULL ) return NULL;
+	rd_lock( &r->lock );
+	if ( (s = r->seg[i]) != NULL ) {
+		big_free( d, n+32 );
+		rd_use( r, s );
+	}
+	else {
+		if ( (s = (rd_seg *) big_alloc( sizeof(rd_seg) )) == NULL ) {
+			rd_unlock( &r->lock );
+			big_free( d, n+32 );
+			return NULL;
+		}
+		s->i = i;
+		s->n = n;
+		s->data = d;
+		s->refs = 1;
+		rd_evict( r, s->n );
+		r->seg[i] = s;
+		r->cached += s->n;
+	}
+	rd_unlock( &r->lock );
+	return s;
+}
+
+static inline void rd_release( lzuf_reader *r, rd_seg *s )
+{
+	rd_lock( &r->lock );
+	if ( --s->refs == 0 ) rd_push( r, s );
+	rd_unlock( &r->lock );
+}
+
+int64_t lzuf_pread( lzuf_reader *r, void *buf, size_t len, int64_t offset )
+{
+	unsigned char *b = (unsigned char *) buf;
+	unsigned int lo, hi, mid, k, m;
+	int64_t done = 0;
+	rd_seg *s;
+	
+	if ( offset < 0 ) return -1;
+	if ( offset >= r->size || len == 0 ) return 0;
+	if ( (int64_t) len > r->size - offset ) len = (size_t) (r->size - offset);
+	
+	/* the last restart point at or before the offset. */
+	lo = 0;
+	hi = r->ntab;
+	while ( hi-lo > 1 ) {
+		mid = lo + (hi-lo)/2;
+		if ( r->tab[2*mid] <= offset ) lo = mid;
+		else hi = mid;
+	}
+	while ( done < (int64_t) len ) {
+		if ( offset+done >= r->tab[2*lo+2] ) lo++;
+		if ( (s = rd_get( r, lo )) == NULL ) return -1;
+		k = (unsigned int) (offset+done - r->tab[2*lo]);
+		m = s->n-k;
+		if ( m > len-done ) m = (unsigned int) (len-done);
+		memcpy( b+done, s->data+k, m );
+		rd_release( r, s );
+		done += m;
+	}
+	return done;
+}
+
+/* writes the range with a reader, which starts at the restart point before it. */
+void read_range( const char *name )
+{
+	lzuf_reader *r;
+	unsigned char *b;
+	int64_t o = rng_START, n = 0;
+	
+	if ( (r = lzuf_open( name, 0 )) == NULL ) {
+		fprintf(stderr, "\nError: bad seek table.");
+		return;
+	}
+	if ( (b = (unsigned char *) big_alloc( 1<<20 )) == NULL ) {
+		fprintf(stderr, "\nError alloc: range buffer.");
+		exit (0);
+	}
+	while ( o < rng_END && (n = lzuf_pread( r, b, rng_END-o < (1<<20) ? rng_END-o : (1<<20), o )) > 0 ) {
+		pfwrite( b, n );
+		o += n;
+	}
+	if ( n < 0 ) fprintf(stderr, "\nError: corrupt block.");
+	big_free( b, 1<<20 );
+	lzuf_close( r );
+}
+
+/* ---- files (lzuf.h) ---- */
+
+int64_t lzuf_decompress_file( const char *in, const char *out, int mtf )
+{
+	int ok;
+	
+	lib_init();
+	if ( (gIN = fopen( in, "rb" )) == NULL ) return -1;
+	if ( (pOUT = fopen( out, "w+b" )) == NULL ) {
+		fclose( gIN );
+		gIN = NULL;
+		return -1;
+	}
+	init_buffer_sizes( (1<<20) );
+	mtf_MODE = mtf;
+	rng_MODE = 0;
+	ok = decode_file( in );
+	free_put_buffer();
+	free_get_buffer();
+	free_mtf_table();
+	arena_close();
+	fclose( gIN );
+	fclose( pOUT );
+	gIN = pOUT = NULL;
+	return ok ? nbytes_out : -1;
+}
+
+/* ---- small payloads (lzuf.h) ---- */
+
+struct lzuf_ctx {
+	int32_t head[1<<SMALL_HASH_BITS];    /* the last position of each hash; -1 if none. */
+	uint16_t prev[LZUF_SMALL_MAX];       /* the distance back to the last position of
+	                                        the same hash; 0 if none. */
+};
+
+lzuf_ctx *lzuf_ctx_new( void )
+{
+	lib_init();
+	return (lzuf_ctx *) big_alloc( sizeof(lzuf_ctx) );
+}
+
+void lzuf_ctx_free( lzuf_ctx *c )
+{
+	big_free( c, sizeof(lzuf_ctx) );
+}
+
+void lzuf_set_allocator( const lzuf_allocator *a )
+{
+	big_ALLOC = a ? a->alloc : NULL;
+	big_FREE = a ? a->free : NULL;
+	big_OPAQUE = a ? a->opaque : NULL;
+	big_HUGE = a ? a->huge_pages : 1;
+}
+
+static inline void small_insert( lzuf_ctx *c, const unsigned char *p, unsigned int i,
+	unsigned int shift )
+{
+	unsigned int h = (load32( p+i ) * HASH_MUL) >> shift;
+	
+	c->prev[i] = c->head[h] < 0 ? 0 : i - c->head[h];
+	c->head[h] = i;
+}
+
+/*
+Writes a sequence of lit literals at p and a match of len bytes at
+distance dist (none if len is 0) as a byte-aligned token (put_fast());
+returns NULL if it does not fit before bend.
+*/
+static inline unsigned char *small_seq( unsigned char *b, unsigned char *bend,
+	const unsigned char *p, unsigned int lit, unsigned int len, unsigned int dist )
+{
+	unsigned int ln = len ? len - MIN_LEN : 0;
+	
+	if ( (size_t) (bend-b) < (size_t) lit + lit/255 + ln/255 + 5 ) return NULL;
+	*b++ = ((lit < 15 ? lit : 15) << 4) | (ln < 15 ? ln : 15);
+	if ( lit >= 15 ) b = put_ext( b, lit-15 );
+	memcpy( b, p, lit );
+	b += lit;
+	if ( len == 0 ) return b;
+	*b++ = (dist-1) & 0xff;
+	*b++ = ((dist-1) >> 8) & 0xff;
+	if ( ln >= 15 ) b = put_ext( b, ln-15 );
+	return b;
+}
+
+/*
+A greedy parse of the payload with hash chains, as one byte-aligned
+block (FMT_BYTE) with 2-byte distances; the window is the payload
+itself, and the hash table is sized to it, so a call only clears
+as many entries as the payload has bytes. The payload is stored if
+it does not get smaller.
+*/
+int64_t lzuf_compress_small( lzuf_ctx *c, const void *src, size_t n, void *dst, size_t cap )
+{
+	const unsigned char *p = (const unsigned char *) src;
+	unsigned char *d = (unsigned char *) dst, *b, *bend;
+	unsigned int hb, shift, i, j, k, lim, anchor = 0, len, best, dist = 0, hdr = 1;
+	int32_t cand;
+	
+	if ( n > LZUF_SMALL_MAX || cap < LZUF_SMALL_BOUND(n) ) return -1;
+	for ( k = (unsigned int) n; k >= 128; k >>= 7 ) d[hdr++] = (k & 127) | 128;
+	d[hdr++] = k;
+	if ( n < SMALL_MIN ) goto stored;
+	b = d+hdr;
+	bend = d+hdr+n-1;   /* at least a byte smaller. */
+	
+	for ( hb = 8; hb < SMALL_HASH_BITS && (1u << hb) < n; hb++ ) ;
+	shift = 32-hb;
+	memset( c->head, 0xff, sizeof(int32_t) << hb );
+	lim = (unsigned int) n - MIN_LEN;
+	for ( i = 0; i <= lim; ) {
+		cand = c->head[ (load32( p+i ) * HASH_MUL) >> shift ];
+		small_insert( c, p, i, shift );
+		for ( best = 0, k = SMALL_DEPTH; cand >= 0 && k > 0; k-- ) {
+			/* a longer match has the byte after the best one. */
+			if ( load32( p+cand ) == load32( p+i ) && (best == 0 || p[cand+best] == p[i+best]) ) {
+				len = MIN_LEN + match_len( p+i+MIN_LEN, p+cand+MIN_LEN, (unsigned int) n-i-MIN_LEN );
+				if ( len > best ) {
+					best = len;
+					dist = i-cand;
+					if ( i+len == n || len >= LONG_MATCH ) break;
+				}
+			}
+			if ( c->prev[cand] == 0 ) break;
+			cand -= c->prev[cand];
+		}
+		if ( best == 0 ) {
+			i++;
+			continue;
+		}
+		/* extend the match back over the literals; those positions are in the chains. */
+		for ( j = i; i > anchor && i > dist && p[i-1] == p[i-1-dist]; i--, best++ ) ;
+		if ( (b = small_seq( b, bend, p+anchor, i-anchor, best, dist )) == NULL ) goto stored;
+		for ( k = j+1; k < i+best && k <= lim; k++ ) small_insert( c, p, k, shift );
+		i += best;
+		anchor = i;
+	}
+	if ( anchor < n && (b = small_seq( b, bend, p+anchor, (unsigned int) n-anchor, 0, 0 )) == NULL )
+		goto stored;
+	d[0] = LZUF_SMALL_TAG | SMALL_CODED;
+	return b-d;
+	
+	stored:
+	d[0] = LZUF_SMALL_TAG | SMALL_STORED;
+	memcpy( d+hdr, p, n );
+	return hdr+n;
+}
+
+/* the raw size of a small payload, from its header; -1 if it is not one. */
+static int64_t small_header( const unsigned char *s, size_t n, unsigned int *hdr )
+{
+	int64_t raw = 0;
+	unsigned int k;
+	
+	if ( n < 2 || (s[0] & ~1) != LZUF_SMALL_TAG ) return -1;
+	for ( k = 1; k < n && k < 4; k++ ) {
+		raw |= (int64_t) (s[k] & 127) << (7*(k-1));
+		if ( !(s[k] & 128) ) break;
+	}
+	if ( k == n || k == 4 || raw > LZUF_SMALL_MAX ) return -1;
+	*hdr = k+1;
+	return raw;
+}
+
+int64_t lzuf_small_size( const void *src, size_t n )
+{
+	unsigned int hdr;
+	
+	return small_header( (const unsigned char *) src, n, &hdr );
+}
+
+/* decodes straight into dst, which needs no slack (get_fast_tight()). */
+int64_t lzuf_decompress_small( const void *src, size_t n, void *dst, size_t cap )
+{
+	unsigned char *s = (unsigned char *) src;
+	unsigned int hdr;
+	int64_t raw = small_header( s, n, &hdr );
+	
+	if ( raw < 0 || (size_t) raw > cap ) return -1;
+	if ( (s[0] & 1) == SMALL_STORED ) {
+		if ( n-hdr != (size_t) raw ) return -1;
+		memcpy( dst, s+hdr, raw );
+	}
+	else if ( !get_fast_tight( s+hdr, (unsigned int) (n-hdr), (unsigned char *) dst,
+		(unsigned int) raw, 0 ) ) return -1;
+	return raw;
 }
@@ -0,0 +1,83 @@
+/*
+	Filename:   LZUFMT.C
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+
+	The file stamp of the LZUF coders: the format version and dialect,
+	and its little-endian layout (see lzufmt.h).
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lzufmt.h"
+
+/* the stamp of a new file; file_size is written at the end. */
+void set_stamp( file_stamp *s, int dialect )
+{
+	memset( s, 0, sizeof(file_stamp) );
+	strcpy( s->algorithm, "LZUF" );
+	s->algorithm[5] = LZUF_VERSION;
+	s->algorithm[6] = dialect;
+}
+
+/* the stamp in its LZUF_STAMP_SIZE bytes. */
+void put_stamp( unsigned char *b, const file_stamp *s )
+{
+	int i;
+
+	memcpy( b, s->algorithm, 8 );
+	for ( i = 0; i < 8; i++ ) b[8+i] = (unsigned char) ((uint64_t) s->file_size >> (8*i));
+	for ( i = 0; i < 4; i++ ) b[16+i] = (unsigned char) ((unsigned int) s->num_pos_bits >> (8*i));
+	for ( i = 0; i < 4; i++ ) b[20+i] = (unsigned char) ((unsigned int) s->format >> (8*i));
+}
+
+void get_stamp( const unsigned char *b, file_stamp *s )
+{
+	uint64_t n = 0;
+	unsigned int k = 0, f = 0;
+	int i;
+
+	memcpy( s->algorithm, b, 8 );
+	for ( i = 7; i >= 0; i-- ) n = (n << 8) | b[8+i];
+	for ( i = 3; i >= 0; i-- ) k = (k << 8) | b[16+i];
+	for ( i = 3; i >= 0; i-- ) f = (f << 8) | b[20+i];
+	s->file_size = (int64_t) n;
+	s->num_pos_bits = (int) k;
+	s->format = (int) f;
+}
+
+/*
+Returns the dialect of a stamp, or -1 if it is not an LZUF file,
+or is of a newer version, or has format options it does not know.
+The stamps of lzuf62 and lzuf621 are written from a local variable,
+so only their first 4 bytes, the file size and the window size are
+known; their format is set to 0.
+*/
+int stamp_dialect( file_stamp *s )
+{
+	int d;
+
+	if ( memcmp( s->algorithm, "LZU", 4 ) == 0 ) {
+		s->format = 0;
+		return LZUF_MTF;
+	}
+	if ( memcmp( s->algorithm, "LZUF", 5 ) != 0 ) return -1;
+	if ( s->format & ~FMT_KNOWN ) return -1;
+	if ( s->algorithm[5] == 0 ) return LZUF_LEGACY;
+	if ( s->algorithm[5] > LZUF_VERSION ) return -1;
+	d = s->algorithm[6];
+	if ( d != LZUF_RAW && d != LZUF_MTF ) return -1;
+	/* the MTF dialect has only the original bitstream. */
+	if ( d == LZUF_MTF && s->format != FMT_STREAM ) return -1;
+	return d;
+}
+
+const char *dialect_name( int dialect )
+{
+	switch ( dialect ) {
+		case LZUF_RAW: return "raw literals (lzuf624)";
+		case LZUF_MTF: return "MTF literals (lzuf622)";
+		default: return "unknown";
+	}
+}
@@ -0,0 +1,136 @@
+/*
+	Filename:   LZUFMT.H
+	Author:     Gerald Tamayo
+	Date:       10/19/2026
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if !defined(LZUFMT_H)
+	#define LZUFMT_H
+
+/* The file stamp of the LZUF coders.
+
+The programs write two dialects of the same bitstream, which
+differ only in how a literal byte is coded:
+
+	LZUF_MTF:  the move-to-front rank of the byte, as a VL code
+	           (lzuf62, lzuf621, lzuf622; lzuf624 -m);
+	LZUF_RAW:  the 8 bits of the byte (lzuf624).
+
+algorithm[] is "LZU" in the files of lzuf62 and lzuf621, which are
+of the MTF dialect. It is "LZUF" otherwise, followed by the stamp
+version (algorithm[5]) and the dialect (algorithm[6]); both bytes
+are 0 in the files written before the stamp had them, so the
+dialect of such a file is not known (LZUF_LEGACY).
+
+The frame, version 2; all the numbers are little-endian:
+
+	the stamp, LZUF_STAMP_SIZE bytes:
+	   0  "LZUF" and a 0 byte;
+	   5  the version;
+	   6  the dialect;
+	   7  0;
+	   8  the content size (64-bit);
+	  16  the window bits (32-bit), 12..26;
+	  20  the format (32-bit): a profile and its options (FMT_*).
+
+	FMT_STREAM:  the LZUF bitstream of the content.
+
+	FMT_SPLIT, FMT_BYTE:  blocks, up to the content size:
+	   0  the type, BLK_CODED, BLK_STORED or BLK_LONG;
+	   1  the raw size (32-bit), at most 64KB or the window size
+	      (any size for BLK_LONG);
+	   5  the size n of the payload (32-bit);
+	   9  the payload: the coded block, the raw bytes, or the distance
+	      of a long match (64-bit), which copies earlier content;
+	 9+n  the XXH32 of the raw bytes (32-bit), with FMT_CHECKSUM;
+	  and after the last block, the XXH32 of the content (32-bit),
+	  with FMT_CHECKSUM.
+
+	With FMT_SEEK, the blocks have restart points, where a match does
+	not reach back before the block, and the frame ends with a seek
+	table of the restart points, which is read from the end of the file:
+	   0  for each restart point: its content offset and the frame
+	      offset of its block header (64-bit each);
+	16*n  the content size (64-bit);
+	+8    the number n of restart points (32-bit);
+	+12   LZUF_SEEK_MAGIC.
+	A decoder that starts at a restart point needs nothing before it.
+
+	With FMT_EOS the content size is 0, and the content ends in-band:
+	the bitstream with a MIN_LEN match (01) at the window position being
+	written, a distance of the window size that a match does not have
+	otherwise; the blocks with a BLK_END byte.
+
+A small payload (lzuf_compress_small(), lzuf.h) has no stamp:
+	   0  LZUF_SMALL_TAG | SMALL_STORED or SMALL_CODED;
+	   1  the raw size, at most LZUF_SMALL_MAX, 7 bits a byte, low bits
+	      first, the high bit set in all but the last byte (1..3 bytes);
+	      then the raw bytes, or a byte-aligned block (FMT_BYTE) with
+	      2-byte distances.
+
+A coded block may refer to the window before it, so it is decoded
+after the blocks before it; a stored block stands alone. Version 1
+has the same layout, with no FMT_CHECKSUM; the stamp was written
+with fwrite(), which is the same on a little-endian machine.
+*/
+#define LZUF_VERSION      2
+#define LZUF_STAMP_SIZE  24
+
+/* dialects. */
+#define LZUF_LEGACY       0
+#define LZUF_RAW          1
+#define LZUF_MTF          2
+
+/* format profiles (low byte of file_stamp.format). */
+#define FMT_STREAM        0    /* the original single LZUF bitstream. */
+#define FMT_SPLIT         1    /* block-framed; four separate streams per block. */
+#define FMT_BYTE          2    /* block-framed; byte-aligned tokens. */
+#define FMT_MASK       0xff
+
+/* format options (file_stamp.format). */
+#define FMT_LITRUNS   0x100    /* literal runs: 00 + vlcode(run-1) + the bytes. */
+#define FMT_REPS      0x200    /* repeat distances: 1 + the index of one of the last
+                                  REP_N distances, or 0 + the position. */
+#define FMT_LONG      0x400    /* long-match blocks (BLK_LONG). */
+#define FMT_CHECKSUM  0x800    /* block and content checksums (XXH32). */
+#define FMT_EOS      0x1000    /* the content size is not known; it ends in-band. */
+#define FMT_SEEK     0x2000    /* restart points, and a seek table at the end. */
+#define FMT_KNOWN     (FMT_MASK | FMT_LITRUNS | FMT_REPS | FMT_LONG | FMT_CHECKSUM | FMT_EOS \
+	| FMT_SEEK)
+
+/* the seek table. */
+#define LZUF_SEEK_MAGIC   "LZSK"
+#define LZUF_SEEK_ENTRY  16
+#define LZUF_SEEK_FOOTER 16
+
+/* block types, and the size of a block header. */
+#define BLK_END           0    /* the end of the blocks (FMT_EOS); no header. */
+#define BLK_CODED         1
+#define BLK_STORED        2    /* raw bytes. */
+#define BLK_LONG          3    /* a copy of earlier content: the distance (64-bit). */
+#define BLK_HDR_SIZE      9
+
+/* small payloads. */
+#define LZUF_SMALL_TAG 0xb0
+#define SMALL_STORED      0
+#define SMALL_CODED       1
+
+typedef struct {
+	char algorithm[8];
+	int64_t file_size;
+	int num_pos_bits;
+	int format;       /* format profile; was padding, so 0 in older files. */
+} file_stamp;
+
+/* ---- function prototypes. ---- */
+void set_stamp( file_stamp *s, int dialect );
+void put_stamp( unsigned char *b, const file_stamp *s );
+void get_stamp( const unsigned char *b, file_stamp *s );
+int stamp_dialect( file_stamp *s );
+const char *dialect_name( int dialect );
+
+#endif
@@ -1,6 +1,9 @@
 /*
 	Filename:	mtf.c
 	Written by:	Gerald R. Tamayo, 2005/2023
+	
+	set_mtf_table(): the table is of the program (say, from an arena),
+	and is not freed here. (10/19/2026)
 */
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,6 +12,7 @@
 
 int tSIZE = 0;
 mtf_list_t *p = NULL, *head = NULL, *table = NULL;
+static int table_EXT = 0;
 
 int alloc_mtf( int tsize )
 {
@@ -23,6 +27,15 @@ int alloc_mtf( int tsize )
 	return 1;
 }
 
+void set_mtf_table( mtf_list_t *t, int tsize )
+{
+	free_mtf_table();
+	table = t;
+	tSIZE = tsize;
+	table_EXT = 1;
+	init_mtf();
+}
+
 void init_mtf(void)
 {
 	int i;
@@ -41,7 +54,9 @@ void init_mtf(void)
 
 void free_mtf_table( void )
 {
-	if ( table ) free( table );
+	if ( table && !table_EXT ) free( table );
+	table = NULL;
+	table_EXT = 0;
 }
 
 static inline int mtf( int c )
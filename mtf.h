@@ -20,6 +20,7 @@ extern int tSIZE;
 extern mtf_list_t *p, *head, *table;
 
 int alloc_mtf( int size );
+void set_mtf_table( mtf_list_t *t, int tsize );
 void init_mtf( void );
 void free_mtf_table( void );
 static inline int mtf( int c );
@@ -0,0 +1,121 @@
+/*
+	Filename:  XXH32.C, Ver. 1, 10/19/2026
+	Author:    Gerald R. Tamayo
+
+	The 32-bit xxHash (XXH32) of Yann Collet, for the block and frame
+	checksums; 4 lanes of 32 bits each take a 16-byte stripe at a time.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+#include "xxh32.h"
+
+#define XXH_P1  0x9E3779B1u
+#define XXH_P2  0x85EBCA77u
+#define XXH_P3  0xC2B2AE3Du
+#define XXH_P4  0x27D4EB2Fu
+#define XXH_P5  0x165667B1u
+
+#define xxh_rotl(x,r) (((x) << (r)) | ((x) >> (32-(r))))
+
+/* little-endian 32-bit load. */
+static inline uint32_t xxh_read32( const unsigned char *b )
+{
+	return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t) b[3] << 24);
+}
+
+static inline uint32_t xxh_round( uint32_t acc, uint32_t k )
+{
+	acc += k * XXH_P2;
+	acc = xxh_rotl( acc, 13 );
+	return acc * XXH_P1;
+}
+
+void xxh32_init( xxh32_t *s, uint32_t seed )
+{
+	memset( s, 0, sizeof(xxh32_t) );
+	s->seed = seed;
+	s->v[0] = seed + XXH_P1 + XXH_P2;
+	s->v[1] = seed + XXH_P2;
+	s->v[2] = seed;
+	s->v[3] = seed - XXH_P1;
+}
+
+void xxh32_update( xxh32_t *s, const void *data, size_t n )
+{
+	const unsigned char *b = (const unsigned char *) data, *end = b + n;
+	uint32_t v0, v1, v2, v3;
+
+	s->total += (uint32_t) n;
+	if ( n >= 16 || s->total >= 16 ) s->big = 1;
+
+	/* not a whole stripe yet. */
+	if ( s->memsize + n < 16 ) {
+		memcpy( s->mem + s->memsize, b, n );
+		s->memsize += n;
+		return;
+	}
+	/* complete the partial stripe. */
+	if ( s->memsize ) {
+		memcpy( s->mem + s->memsize, b, 16 - s->memsize );
+		b += 16 - s->memsize;
+		s->v[0] = xxh_round( s->v[0], xxh_read32( s->mem ) );
+		s->v[1] = xxh_round( s->v[1], xxh_read32( s->mem+4 ) );
+		s->v[2] = xxh_round( s->v[2], xxh_read32( s->mem+8 ) );
+		s->v[3] = xxh_round( s->v[3], xxh_read32( s->mem+12 ) );
+		s->memsize = 0;
+	}
+	v0 = s->v[0]; v1 = s->v[1]; v2 = s->v[2]; v3 = s->v[3];
+	while ( end - b >= 16 ) {
+		v0 = xxh_round( v0, xxh_read32( b ) );
+		v1 = xxh_round( v1, xxh_read32( b+4 ) );
+		v2 = xxh_round( v2, xxh_read32( b+8 ) );
+		v3 = xxh_round( v3, xxh_read32( b+12 ) );
+		b += 16;
+	}
+	s->v[0] = v0; s->v[1] = v1; s->v[2] = v2; s->v[3] = v3;
+	if ( b < end ) {
+		memcpy( s->mem, b, end - b );
+		s->memsize = (unsigned int) (end - b);
+	}
+}
+
+uint32_t xxh32_digest( const xxh32_t *s )
+{
+	const unsigned char *b = s->mem, *end = s->mem + s->memsize;
+	uint32_t h;
+
+	if ( s->big ) h = xxh_rotl( s->v[0], 1 ) + xxh_rotl( s->v[1], 7 )
+		+ xxh_rotl( s->v[2], 12 ) + xxh_rotl( s->v[3], 18 );
+	else h = s->seed + XXH_P5;
+	h += s->total;
+
+	/* the tail: 4 bytes, then 1 byte at a time. */
+	while ( end - b >= 4 ) {
+		h += xxh_read32( b ) * XXH_P3;
+		h = xxh_rotl( h, 17 ) * XXH_P4;
+		b += 4;
+	}
+	while ( b < end ) {
+		h += (*b++) * XXH_P5;
+		h = xxh_rotl( h, 11 ) * XXH_P1;
+	}
+
+	/* avalanche. */
+	h ^= h >> 15;
+	h *= XXH_P2;
+	h ^= h >> 13;
+	h *= XXH_P3;
+	h ^= h >> 16;
+	return h;
+}
+
+uint32_t xxh32( const void *data, size_t n, uint32_t seed )
+{
+	xxh32_t s;
+
+	xxh32_init( &s, seed );
+	xxh32_update( &s, data, n );
+	return xxh32_digest( &s );
+}
@@ -0,0 +1,30 @@
+/* XXH32.H, Ver. 1, 10/19/2026 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>  /* C99 */
+
+#if !defined( XXH32_H )
+	#define XXH32_H
+
+/* The 32-bit xxHash of Yann Collet (XXH32), a fast non-cryptographic
+checksum; the sums are those of the reference implementation.
+
+A sum is computed in one call with xxh32(), or over pieces of the
+data with xxh32_init(), xxh32_update() and xxh32_digest().
+*/
+typedef struct {
+	uint32_t v[4];          /* the four lanes. */
+	uint32_t total;         /* bytes so far (mod 2^32). */
+	int big;                /* 16 bytes or more so far. */
+	unsigned char mem[16];  /* a partial stripe. */
+	unsigned int memsize;
+	uint32_t seed;
+} xxh32_t;
+
+void xxh32_init( xxh32_t *s, uint32_t seed );
+void xxh32_update( xxh32_t *s, const void *data, size_t n );
+uint32_t xxh32_digest( const xxh32_t *s );
+uint32_t xxh32( const void *data, size_t n, uint32_t seed );
+
+#endif